@@ -77,9 +77,33 @@ QMAKE_SUBSTITUTES += openhab.json.in version.txt.in
 # output path must be included for the output file from QMAKE_SUBSTITUTES
 INCLUDEPATH += $$OUT_PWD
 HEADERS  += src/openhab.h \
-    src/openhab_channelmappings.h
+    src/openhab_channelmappings.h \
+    src/openhab_commandqueue.h \
+    src/openhab_commandtracer.h \
+    src/openhab_entityupdater.h \
+    src/openhab_eventdecoder.h \
+    src/openhab_itemsreader.h \
+    src/openhab_jsonscanner.h \
+    src/openhab_metrics.h \
+    src/openhab_reconnectscheduler.h \
+    src/openhab_requestfactory.h \
+    src/openhab_snapshot.h \
+    src/openhab_sseparser.h \
+    src/openhab_stateparser.h
 SOURCES  += src/openhab.cpp \
-    src/openhab_channelmappings.cpp
+    src/openhab_channelmappings.cpp \
+    src/openhab_commandqueue.cpp \
+    src/openhab_commandtracer.cpp \
+    src/openhab_entityupdater.cpp \
+    src/openhab_eventdecoder.cpp \
+    src/openhab_itemsreader.cpp \
+    src/openhab_jsonscanner.cpp \
+    src/openhab_metrics.cpp \
+    src/openhab_reconnectscheduler.cpp \
+    src/openhab_requestfactory.cpp \
+    src/openhab_snapshot.cpp \
+    src/openhab_sseparser.cpp \
+    src/openhab_stateparser.cpp
 TARGET    = openhab
 
 # Configure destination path. DESTDIR is set in qmake-destination-path.pri
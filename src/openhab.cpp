@@ -28,16 +28,19 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QNetworkInterface>
+#include <QStandardPaths>
 #include <QString>
+#include <QThread>
 
 #include "openhab_channelmappings.h"
+#include "openhab_snapshot.h"
 #include "yio-interface/entities/blindinterface.h"
 #include "yio-interface/entities/entityinterface.h"
 #include "yio-interface/entities/lightinterface.h"
 #include "yio-interface/entities/mediaplayerinterface.h"
 #include "yio-interface/entities/switchinterface.h"
 
-OpenHABPlugin::OpenHABPlugin() : Plugin("yio.plugin.openhab", NO_WORKER_THREAD) {}
+OpenHABPlugin::OpenHABPlugin() : Plugin("yio.plugin.openhab", USE_WORKER_THREAD) {}
 
 Integration* OpenHABPlugin::createIntegration(const QVariantMap& config, EntitiesInterface* entities,
                                               NotificationsInterface* notifications, YioAPIInterface* api,
@@ -49,6 +52,8 @@ Integration* OpenHABPlugin::createIntegration(const QVariantMap& config, Entitie
 OpenHAB::OpenHAB(const QVariantMap& config, EntitiesInterface* entities, NotificationsInterface* notifications,
                  YioAPIInterface* api, ConfigInterface* configObj, Plugin* plugin)
     : Integration(config, entities, notifications, api, configObj, plugin) {
+    int commandInterval = DEFAULT_COMMAND_INTERVAL;
+    int metricsLogInterval = 0;
     for (QVariantMap::const_iterator iter = config.begin(); iter != config.end(); ++iter) {
         if (iter.key() == "url") {
             _url = iter.value().toString();
@@ -56,6 +61,30 @@ OpenHAB::OpenHAB(const QVariantMap& config, EntitiesInterface* entities, Notific
         if (iter.key() == "token") {
             _token = iter.value().toString();
         }
+        if (iter.key() == "commandInterval") {
+            commandInterval = iter.value().toInt();
+        }
+        if (iter.key() == "optimistic") {
+            _optimistic = iter.value().toBool();
+        }
+        if (iter.key() == "optimisticTimeout") {
+            _optimisticTimeout = iter.value().toInt();
+        }
+        if (iter.key() == "stateChangedEvents") {
+            _stateChangedEvents = iter.value().toBool();
+        }
+        if (iter.key() == "snapshotMaxAge") {
+            _snapshotMaxAge = iter.value().toInt();
+        }
+        if (iter.key() == "sseIdleTimeout") {
+            _sseIdleTimeout = qMax(1, iter.value().toInt());
+        }
+        if (iter.key() == "sseMaxIdle") {
+            _sseMaxIdle = iter.value().toInt();
+        }
+        if (iter.key() == "metricsLogInterval") {
+            metricsLogInterval = iter.value().toInt();
+        }
     }
     if (!_url.contains("rest")) {
         if (!_url.endsWith('/')) {
@@ -67,9 +96,33 @@ OpenHAB::OpenHAB(const QVariantMap& config, EntitiesInterface* entities, Notific
         _url += "/";
     }
     context_openHab = this;
-    _sseNetworkManager = new QNetworkAccessManager(context_openHab);
-    _sseReconnectTimer = new QTimer(context_openHab);
+    _sseScheduler = new OpenHABReconnectScheduler(RECONNECT_INITIAL_DELAY, RECONNECT_MAX_DELAY, context_openHab);
+    _probeScheduler = new OpenHABReconnectScheduler(RECONNECT_INITIAL_DELAY, RECONNECT_MAX_DELAY, context_openHab);
+    QObject::connect(_sseScheduler, &OpenHABReconnectScheduler::attempt, context_openHab, &OpenHAB::onSseTimeout);
+    QObject::connect(_probeScheduler, &OpenHABReconnectScheduler::attempt, context_openHab, &OpenHAB::onProbeTimeout);
+    _requests = OpenHABRequestFactory(_url, _token);
     _nam = new QNetworkAccessManager(context_openHab);
+    _commandQueue = new OpenHABCommandQueue(
+        [this](const QString& itemId, const QString& state) { return postCommand(itemId, state); }, context_openHab);
+    _commandQueue->setMinInterval(commandInterval);
+    _updater = new OpenHABEntityUpdater(context_openHab);
+    _updater->setMinInterval(ENTITY_UPDATE_INTERVAL);
+    _expectationTimer = new QTimer(context_openHab);
+    _expectationTimer->setSingleShot(true);
+    QObject::connect(_expectationTimer, &QTimer::timeout, context_openHab, &OpenHAB::onExpectationTimeout);
+    _clock.start();
+    _watchdogTimer = new QTimer(context_openHab);
+    _watchdogTimer->setInterval(qMax(1000, _sseIdleTimeout * 500));
+    QObject::connect(_watchdogTimer, &QTimer::timeout, context_openHab, &OpenHAB::onWatchdogTimeout);
+    if (metricsLogInterval > 0) {
+        QTimer* metricsTimer = new QTimer(context_openHab);
+        QObject::connect(metricsTimer, &QTimer::timeout, context_openHab, [this]() {
+            collectMetrics();
+            qCInfo(m_logCategory) << "Metrics:" << _metrics.toString();
+        });
+        metricsTimer->start(metricsLogInterval * 1000);
+    }
+    _itemsReader.setCallback([this](const OpenHABItemsReader::Item& item) { onItemRead(item); });
 
     for (QNetworkInterface& iface : QNetworkInterface::allInterfaces()) {
         if (iface.type() == QNetworkInterface::Wifi) {
@@ -82,261 +135,338 @@ OpenHAB::OpenHAB(const QVariantMap& config, EntitiesInterface* entities, Notific
 }
 
 void OpenHAB::streamReceived() {
-    if (_sseReply->error() == QNetworkReply::NoError) {
-        QJsonParseError parseerror;
-        QJsonDocument   doc;
-        QJsonDocument   pyload;
-        QByteArray      rawData;
-        QByteArrayList  splitted;
-
-        rawData.clear();
-        rawData = _sseReply->readAll();
-        splitted = rawData.split('\n');
-
-        for (QByteArray data : splitted) {
-            if ((data.length() == 0) || (data.startsWith("event: message"))) {
-                continue;
-            }
+    if (_sseReply->error() != QNetworkReply::NoError) {
+        qCDebug(m_logCategory) << "streamerror";
+        return;
+    }
 
-            if (_flagMoreDataNeeded) {
-                _tempJSONData = _tempJSONData + QString(data);
-                doc = QJsonDocument::fromJson(_tempJSONData.toUtf8(), &parseerror);
-                _flagMoreDataNeeded = false;
-            } else {
-                doc = QJsonDocument::fromJson(data.mid(6), &parseerror);
-            }
-            if ((parseerror.error == QJsonParseError::UnterminatedString ||
-                 parseerror.error == QJsonParseError::UnterminatedObject ||
-                 parseerror.error == QJsonParseError::IllegalValue ||
-                 parseerror.error == QJsonParseError::IllegalEscapeSequence)) {
-                _tempJSONData = QString(data.mid(6));
-                _flagMoreDataNeeded = true;
-            } else if (_tempJSONData != "") {
-                _flagMoreDataNeeded = false;
-                _tempJSONData = "";
-            }
+    if (_sseScheduler->attempts() > 0) {
+        // stream is alive again
+        _sseScheduler->reset();
+    }
+    QByteArray chunk = _sseReply->readAll();
+    _metrics.add(OpenHABMetrics::SSE_BYTES, chunk.size());
+    _sseLastData = _clock.elapsed();
+    _sseParser.append(chunk);
 
-            if (parseerror.error == QJsonParseError::GarbageAtEnd) {
-                doc = QJsonDocument::fromJson(data.mid(6).left(data.lastIndexOf("}") + 1), &parseerror);
-            }
+    OpenHABSseParser::Event event;
+    while (_sseParser.takeEvent(&event)) {
+        // openHAB sends its bus events as plain messages, other event types are keep alive notifications
+        if (event.type == "message") {
+            _metrics.add(OpenHABMetrics::SSE_EVENTS);
+            processEvent(event.data);
+        } else if (event.type == "alive") {
+            _sseHeartbeat = true;
+        }
+    }
+    if (_sseParser.hasPartialEvent()) {
+        _metrics.add(OpenHABMetrics::SSE_PARTIAL_FRAMES);
+    }
+}
 
-            if (parseerror.error != QJsonParseError::NoError && !_flagMoreDataNeeded) {
-                qCDebug(m_logCategory) << QString(doc.toJson(QJsonDocument::Compact)) << "read " << data.size()
-                                       << "bytes"
-                                       << "read data" << data.mid(6) << "SSE JSON error:" << parseerror.error
-                                       << parseerror.errorString();
-                continue;
-            }
-            // only process state changes
-            if (!_flagMoreDataNeeded) {
-                if ((doc.object().value("type").toString() == "ItemStateEvent") ||
-                    (doc.object().value("type").toString() == "GroupItemStateChangedEvent")) {
-                    // get item name from the topic string
-                    // example: smarthome/items/EG_Esszimmer_Sonos_CurrentPlayingTime/state
-                    QString          name = doc.object().value("topic").toString().split('/')[2];
-                    EntityInterface* entity = m_entities->getEntityInterface(name);
-                    if (entity != nullptr && entity->connected()) {
-                        pyload =
-                            QJsonDocument::fromJson(doc.object().value("payload").toString().toUtf8(), &parseerror);
-                        if (parseerror.error != QJsonParseError::NoError && !_flagMoreDataNeeded) {
-                            qCDebug(m_logCategory)
-                                << QString(pyload.toJson(QJsonDocument::Compact)) << "read "
-                                << doc.object().value("payload").toString().size() << "bytes"
-                                << "read " << doc.object().value("payload").toString()
-                                << "SSE JSON pyload error:" << parseerror.error << parseerror.errorString();
-                            continue;
-                        }
-                        // because OpenHab doesn't send the item type in the status update, we have to extract it from
-                        // our own entity library
-                        if (pyload.object().value("value").toString() != "UNDEF") {
-                            if (entity->type() == "light" && entity->supported_features().contains("BRIGHTNESS") &&
-                                _brightnessValueTemplate.exactMatch(pyload.object().value("value").toString())) {
-                                processLight(pyload.object().value("value").toString(), entity, true);
-                            } else if (entity->type() == "light" && entity->supported_features().contains("COLOR") &&
-                                       _colorValueTemplate.exactMatch(pyload.object().value("value").toString())) {
-                                processComplexLight(pyload.object().value("value").toString(), entity);
-                            } else if (entity->type() == "light") {
-                                processLight(pyload.object().value("value").toString(), entity, false);
-                            } else if (entity->type() == "blind") {
-                                processBlind(pyload.object().value("value").toString(), entity);
-                            } else if (entity->type() == "switch") {
-                                processSwitch(pyload.object().value("value").toString(), entity);
-                            }
-                        }
-                    } else if (entity == nullptr) {
-                        // qCDebug(m_logCategory) << QString("openHab Item %1 is not configured").arg(name);
-                    } else {
-                        qCDebug(m_logCategory) << QString("Entity %1 is offline").arg(name);
-                    }
-                }
-            }
-            doc = QJsonDocument();
-            pyload = QJsonDocument();
-            data.clear();
+void OpenHAB::processEvent(const QByteArray& data) {
+    OpenHABEventDecoder::Event event;
+
+    // most events on the openHAB bus are for items which are not used by this integration: drop them before decoding
+    QByteArray item = OpenHABEventDecoder::peekItem(data);
+    if (!item.isEmpty() && !_itemFilter.contains(item)) {
+        _metrics.add(OpenHABMetrics::EVENTS_UNCONFIGURED);
+        return;
+    }
+
+    if (!_eventDecoder.decode(data, &event)) {
+        _metrics.add(OpenHABMetrics::JSON_ERRORS);
+        qCDebug(m_logCategory) << "SSE JSON error in event of" << data.size() << "bytes";
+        return;
+    }
+    // only process states, without a server side filter both state events are received
+    OpenHABEventDecoder::Type stateEvent =
+        _stateChangedEvents ? OpenHABEventDecoder::ITEM_STATE_CHANGED : OpenHABEventDecoder::ITEM_STATE;
+    if (event.type != stateEvent && event.type != OpenHABEventDecoder::GROUP_ITEM_STATE_CHANGED) {
+        return;
+    }
+
+    auto binding = _entityIndex.find(QString::fromLatin1(event.item));
+    if (binding == _entityIndex.end()) {
+        _metrics.add(OpenHABMetrics::EVENTS_UNCONFIGURED);
+        return;
+    }
+    if (_tracer.hasOpenTraces()) {
+        qint64 now = _clock.elapsed();
+        qint64 posted = _tracer.echoed(binding.key(), now);
+        if (posted >= 0) {
+            _metrics.record(OpenHABMetrics::COMMAND_ROUND_TRIP, now - posted);
         }
-        rawData.clear();
-        splitted.clear();
+    }
+    // bindings repeat unchanged states periodically, unless an optimistic state waits for its echo these are dropped
+    bool expected = !_expectations.isEmpty() && _expectations.contains(binding.key());
+    if (!expected && binding->lastValue == event.value) {
+        _metrics.add(OpenHABMetrics::EVENTS_REPEATED);
+        return;
+    }
+    _metrics.add(OpenHABMetrics::EVENTS_PROCESSED);
+    binding->lastValue = QByteArray(event.value.constData(), event.value.size());
+
+    OpenHABState state = OpenHABStateParser::parse(event.value, event.valueType);
+    if (expected) {
+        // the optimistic state is shown until openHAB confirms the latest command or its deadline has passed
+        reconcileState(binding.key(), state);
     } else {
-        qCDebug(m_logCategory) << "streamerror";
+        processState(*binding, state);
     }
 }
 
 void OpenHAB::streamFinished(QNetworkReply* reply) {
-    reply->abort();
+    bool current = _flagSseConnected && reply == _sseReply;
 
+    reply->deleteLater();
+    if (!current) {
+        // stream was closed on purpose
+        return;
+    }
+    _flagSseConnected = false;
+    if (_sseOutageStart < 0) {
+        _sseOutageStart = _sseLastData;
+    }
     if (_flagOpenHabConnected && !_flagStandby) {
         qCDebug(m_logCategory) << "Lost SSE connection to OpenHab";
-        _sseReconnectTimer->start();
+        _sseScheduler->schedule();
     }
-    reply->deleteLater();
 }
 
 void OpenHAB::onSseTimeout() {
-    qCDebug(m_logCategory) << "timer";
-    if (_tries == 3) {
-        disconnect();
-        qCDebug(m_logCategory) << "disconnect 1";
-        qCCritical(m_logCategory) << "Cannot connect to OpenHab: retried 3 times connecting to" << _url;
-        QObject* param = this;
+    if (_flagStandby) {
+        return;
+    }
+    qCDebug(m_logCategory) << "Try to reconnect the OpenHab SSE connection, attempt" << _sseScheduler->attempts();
+    _metrics.add(OpenHABMetrics::SSE_RECONNECTS);
+    if (_sseScheduler->attempts() >= RECONNECT_NOTIFY_ATTEMPTS) {
+        notifyConnectionProblem();
+    }
+    startSse();
+}
 
-        m_notifications->add(
-            true, tr("Cannot connect to ").append(friendlyName()).append("."), tr("Reconnect"),
-            [](QObject* param) {
-                Integration* i = qobject_cast<Integration*>(param);
-                i->connect();
-            },
-            param);
+void OpenHAB::onProbeTimeout() {
+    if (!_flagStandby) {
+        getSystemInfo();
+    }
+}
 
-        _tries = 0;
-    } else {
-        if (_flagSseConnected) {
-            if (_sseReply->isRunning()) {
-                _sseReply->abort();
-                QObject::disconnect(_sseReply, &QNetworkReply::readyRead, context_openHab, &OpenHAB::streamReceived);
-                _sseNetworkManager->clearConnectionCache();
-                _flagSseConnected = false;
+void OpenHAB::onProbeFailed(int httpStatus) {
+    _flagOpenHabConnected = false;
+    _metrics.add(OpenHABMetrics::PROBE_FAILURES);
+    if (_probeScheduler->attempts() >= RECONNECT_NOTIFY_ATTEMPTS) {
+        notifyConnectionProblem();
+    }
+    _probeScheduler->schedule();
+    qCInfo(m_logCategory) << "OpenHab not reachable, status" << httpStatus << "- retry" << _probeScheduler->attempts()
+                          << "at" << _probeScheduler->nextAttempt().toString(Qt::ISODate);
+}
+
+void OpenHAB::notifyConnectionProblem() {
+    if (state() != CONNECTED) {
+        // openHAB wasn't reachable since the start: don't show the states of the snapshot as live states,
+        // the bootstrap connects the entities again
+        for (EntityInterface* entity : qAsConst(_myEntities)) {
+            if (_updater->isConnected(entity)) {
+                _updater->setConnected(entity, false);
             }
         }
-        if (!_flagStandby) {
-            startSse();
-            qCDebug(m_logCategory) << "Try to reconnect the OpenHab SSE connection";
-            _sseReconnectTimer->stop();
-            _tries++;
+    }
+    // retries continue in the background, the user is only informed once
+    if (_connectionNotified) {
+        return;
+    }
+    _connectionNotified = true;
+    qCWarning(m_logCategory) << "Cannot connect to OpenHab at" << _url << "- still retrying";
+    m_notifications->add(
+        true, tr("Cannot connect to ").append(friendlyName()).append("."), tr("Reconnect"),
+        [](QObject* param) {
+            Integration* i = qobject_cast<Integration*>(param);
+            i->connect();
+        },
+        this);
+}
+
+void OpenHAB::stopSse() {
+    _watchdogTimer->stop();
+    if (_flagSseConnected) {
+        _flagSseConnected = false;
+        QObject::disconnect(_sseReply, &QNetworkReply::readyRead, context_openHab, &OpenHAB::streamReceived);
+        if (_sseReply->isRunning()) {
+            _sseReply->abort();
         }
     }
 }
 
 void OpenHAB::startSse() {
-    QNetworkRequest request(_url + "events");
-    request.setRawHeader("Accept", "text/event-stream");
-    request.setHeader(QNetworkRequest::UserAgentHeader, "Yio Remote OpenHAB Plugin");
-    if (_token != "") {
-        request.setRawHeader("accept", "*/*");
-        QString token = "Bearer " + _token;
-        request.setRawHeader("Authorization", token.toUtf8());
-    }
-    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
-    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute,
-                         QNetworkRequest::AlwaysNetwork);  // Events shouldn't be cached
-    _sseReply = _sseNetworkManager->get(request);
-    QObject::connect(_sseReply, &QNetworkReply::readyRead, context_openHab, &OpenHAB::streamReceived);
+    stopSse();
+    _sseParser.reset();
+
+    QNetworkReply* reply = _nam->get(_requests.events(_sseTopics));
+    _sseReply = reply;
+    QObject::connect(reply, &QNetworkReply::metaDataChanged, context_openHab, [this, reply]() { streamOpened(reply); });
+    QObject::connect(reply, &QNetworkReply::readyRead, context_openHab, &OpenHAB::streamReceived);
+    QObject::connect(reply, &QNetworkReply::finished, context_openHab, [this, reply]() { streamFinished(reply); });
     _flagSseConnected = true;
+
+    _sseLastData = _clock.elapsed();
+    _sseHeartbeat = false;
+    _watchdogTimer->start();
 }
 
-void OpenHAB::networkManagerFinished(QNetworkReply* reply) {
-    QString answer = reply->readAll();
-    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
-        if (_networktries == 3) {
-            m_notifications->add(
-                true, tr("Cannot connect to ").append(friendlyName()).append("."), tr("Reconnect"),
-                [](QObject* param) {
-                    Integration* i = qobject_cast<Integration*>(param);
-                    i->connect();
-                },
-                this);
-            _flagOpenHabConnected = false;
-            disconnect();
-            qCDebug(m_logCategory) << "disconnect 2"
-                                   << QString::number(
-                                          reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt())
-                                   << "openhab not reachable";
-            _networktries = 0;
-        } else {
-            getSystemInfo();
-            _networktries++;
+void OpenHAB::streamOpened(QNetworkReply* reply) {
+    if (reply != _sseReply || reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
+        return;
+    }
+    if (_sseOutageStart >= 0) {
+        // events sent while the stream was down are lost
+        qint64 outage = _clock.elapsed() - _sseOutageStart;
+        _sseOutageStart = -1;
+        _metrics.record(OpenHABMetrics::SSE_OUTAGE, outage);
+        qCInfo(m_logCategory) << "SSE connection restored after" << outage << "ms";
+        // the bootstrap reads all items anyway
+        if (state() == CONNECTED && !(_itemsReply != nullptr && _itemsBootstrap)) {
+            resyncItems(boundItems());
         }
-    } else if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
-        _networktries = 0;
-        if (state() != CONNECTED && answer.contains("systemInfo")) {
-            qCDebug(m_logCategory) << reply->header(QNetworkRequest::ContentTypeHeader).toString() << " : " << answer;
+    }
+}
 
-            _sseReconnectTimer->setSingleShot(true);
-            _sseReconnectTimer->setInterval(2000);
-            QObject::connect(_sseReconnectTimer, &QTimer::timeout, context_openHab, &OpenHAB::onSseTimeout);
-            _sseReconnectTimer->stop();
+void OpenHAB::onWatchdogTimeout() {
+    if (!_flagSseConnected || _flagStandby) {
+        return;
+    }
+    qint64 idle = _clock.elapsed() - _sseLastData;
+    if (idle < qint64(_sseIdleTimeout) * 1000) {
+        return;
+    }
+    // a stream with heartbeats is dead when they stop, a quiet stream is only renewed after the maximum idle time
+    if (_sseHeartbeat || (_sseMaxIdle > 0 && idle >= qint64(_sseMaxIdle) * 1000)) {
+        qCInfo(m_logCategory) << "No data on the SSE connection for" << idle << "ms, reconnecting";
+        _metrics.add(OpenHABMetrics::SSE_RECONNECTS);
+        if (_sseHeartbeat && _sseOutageStart < 0) {
+            // missing heartbeats mean missed events, a quiet stream is healthy and only renewed
+            _sseOutageStart = _sseLastData;
+        }
+        startSse();
+    } else if (_watchdogProbe == nullptr) {
+        // a half-open connection doesn't fail by itself, check if openHAB is still reachable
+        QNetworkReply* reply = _nam->get(_requests.json("systeminfo"));
+        _watchdogProbe = reply;
+        QObject::connect(reply, &QNetworkReply::finished, context_openHab, [this, reply]() { onWatchdogReply(reply); });
+    }
+}
 
-            QObject::connect(_sseNetworkManager, &QNetworkAccessManager::finished, context_openHab,
-                             &OpenHAB::streamFinished);
+void OpenHAB::onWatchdogReply(QNetworkReply* reply) {
+    reply->deleteLater();
+    if (reply != _watchdogProbe) {
+        return;
+    }
+    _watchdogProbe = nullptr;
+    if (!_flagSseConnected || _flagStandby) {
+        return;
+    }
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (reply->error() != QNetworkReply::NoError || httpStatus != 200) {
+        qCInfo(m_logCategory) << "SSE connection is idle and openHAB doesn't answer, status" << httpStatus;
+        if (_sseOutageStart < 0) {
+            _sseOutageStart = _sseLastData;
+        }
+        stopSse();
+        _sseScheduler->schedule();
+    }
+}
 
-            _flagOpenHabConnected = true;
-            startSse();
-            getItems();
+QStringList OpenHAB::boundItems() const {
+    QStringList items;
+    items.reserve(_entityIndex.size());
+    // entities which weren't loaded are handled by the next bootstrap
+    for (auto i = _entityIndex.constBegin(); i != _entityIndex.constEnd(); ++i) {
+        if (i->handler != nullptr && _updater->isConnected(i->entity)) {
+            items.append(i.key());
+        }
+    }
+    return items;
+}
 
-        } else if (state() != CONNECTED && answer.contains("rest/items/")) {
-            QJsonParseError parseerror;
-            if (answer != "") {
-                QJsonDocument doc = QJsonDocument::fromJson(answer.toUtf8(), &parseerror);
-                if (parseerror.error != QJsonParseError::NoError) {
-                    jsonError(parseerror.errorString());
-                    return;
-                }
-                processItems(doc, true);
-                _flagOpenHabConnected = true;
-                setState(CONNECTED);
-            }
-        } else if (state() == CONNECTED && answer.contains("rest/items/")) {
-            QJsonParseError parseerror;
-            if (answer != "") {
-                QJsonDocument doc = QJsonDocument::fromJson(answer.toUtf8(), &parseerror);
-                if (parseerror.error != QJsonParseError::NoError) {
-                    jsonError(parseerror.errorString());
-                    return;
-                }
-                processItems(doc, false);
-                _flagOpenHabConnected = true;
-            }
-        } else if (state() == CONNECTED && _flagleaveStandby) {
-            _flagOpenHabConnected = true;
-            _flagleaveStandby = false;
-            getItems();
+void OpenHAB::onSystemInfoReply(QNetworkReply* reply) {
+    reply->deleteLater();
+    if (state() == DISCONNECTED) {
+        return;
+    }
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (reply->error() != QNetworkReply::NoError || httpStatus != 200) {
+        onProbeFailed(httpStatus);
+        return;
+    }
+    onProbeSucceeded();
+
+    if (state() != CONNECTED) {
+        qCDebug(m_logCategory) << reply->header(QNetworkRequest::ContentTypeHeader).toString() << " : "
+                               << reply->readAll();
+
+        if (_thingEntities.isEmpty()) {
             startSse();
-        } else if (state() == CONNECTED) {
-            _flagOpenHabConnected = true;
-        }
-    } else {
-        if (_networktries == 3) {
-            m_notifications->add(
-                true, tr("Cannot connect to ").append(friendlyName()).append("."), tr("Reconnect"),
-                [](QObject* param) {
-                    Integration* i = qobject_cast<Integration*>(param);
-                    i->connect();
-                },
-                this);
-            _flagOpenHabConnected = false;
-            disconnect();
-            qCDebug(m_logCategory) << "disconnect 3"
-                                   << "openhab not reachable";
-            _networktries = 0;
+            getItems();
         } else {
-            getSystemInfo();
-            _networktries++;
+            // the items of thing based entities are needed for the event filter
+            getThings();
         }
     }
 }
+
+void OpenHAB::onItemReply(QNetworkReply* reply) {
+    reply->deleteLater();
+    if (state() != CONNECTED || reply->error() == QNetworkReply::OperationCanceledError) {
+        return;
+    }
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (httpStatus == 0) {
+        onProbeFailed(httpStatus);
+        return;
+    }
+    if (httpStatus != 200) {
+        qCWarning(m_logCategory) << "Cannot read item" << reply->url().path() << "status" << httpStatus;
+        return;
+    }
+    onProbeSucceeded();
+
+    QJsonParseError parseerror;
+    QJsonDocument   doc = QJsonDocument::fromJson(reply->readAll(), &parseerror);
+    if (parseerror.error != QJsonParseError::NoError) {
+        jsonError(parseerror.errorString());
+        return;
+    }
+    processItem(doc);
+}
+
+void OpenHAB::onCommandReply(QNetworkReply* reply, const QString& itemId) {
+    // the response body isn't needed, the new state is received through SSE
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    _tracer.replied(itemId, httpStatus, _clock.elapsed());
+    if (httpStatus == 0 && reply->error() != QNetworkReply::OperationCanceledError) {
+        onProbeFailed(httpStatus);
+    } else if (httpStatus >= 300) {
+        qCWarning(m_logCategory) << "Command for" << itemId << "failed with status" << httpStatus;
+    }
+}
+
+void OpenHAB::onProbeSucceeded() {
+    _probeScheduler->reset();
+    _connectionNotified = false;
+    _flagOpenHabConnected = true;
+    if (state() == CONNECTED && !_flagSseConnected && !_sseScheduler->isScheduled() && !_flagStandby) {
+        // the stream failed while openHAB was unreachable and wasn't rescheduled
+        startSse();
+    }
+}
+
 void OpenHAB::connect() {
     setState(CONNECTING);
 
-    if (!_iface.flags().testFlag(QNetworkInterface::IsUp) && !_iface.flags().testFlag(QNetworkInterface::IsRunning)) {
+    // only the WiFi interface of the remote is checked, hosts without one like the test machines connect directly
+    if (_iface.isValid() && !_iface.flags().testFlag(QNetworkInterface::IsUp) &&
+        !_iface.flags().testFlag(QNetworkInterface::IsRunning)) {
         m_notifications->add(
             true, tr("Cannot connect to ").append(friendlyName()).append("."), tr("Reconnect"),
             [](QObject* param) {
@@ -348,51 +478,88 @@ void OpenHAB::connect() {
         qCDebug(m_logCategory) << "setup";
 
         _myEntities = m_entities->getByIntegration(integrationId());
+        buildEntityIndex();
+        if (!_snapshotLoaded) {
+            // cold start: show the last known states until openHAB answers or turns out to be unreachable
+            _snapshotLoaded = true;
+            loadSnapshot();
+        }
 
         _flagStandby = false;
-        QObject::connect(_nam, &QNetworkAccessManager::finished, context_openHab, &OpenHAB::networkManagerFinished);
+        _probeScheduler->reset();
         getSystemInfo();
     }
 }
 
 void OpenHAB::disconnect() {
     qCDebug(m_logCategory) << state();
-    if (_flagSseConnected) {
-        if (_sseReply->isRunning()) {
-            _sseReply->abort();
-            QObject::disconnect(_sseReply, &QNetworkReply::readyRead, context_openHab, &OpenHAB::streamReceived);
-            _sseNetworkManager->clearConnectionCache();
-            _flagSseConnected = false;
-        }
-    }
-    _sseReconnectTimer->stop();
-    QObject::disconnect(_sseNetworkManager, &QNetworkAccessManager::finished, context_openHab,
-                        &OpenHAB::streamFinished);
-    QObject::disconnect(_sseReconnectTimer, &QTimer::timeout, context_openHab, &OpenHAB::onSseTimeout);
-    QObject::disconnect(_nam, &QNetworkAccessManager::finished, context_openHab, &OpenHAB::networkManagerFinished);
+    saveSnapshot();
+    stopSse();
+    _sseScheduler->reset();
+    _probeScheduler->reset();
+    _flagOpenHabConnected = false;
+    _sseOutageStart = -1;
+
+    _commandQueue->clear();
+    _expectations.clear();
+    _expectationTimer->stop();
+    collectMetrics();
+    qCDebug(m_logCategory) << "Metrics:" << _metrics.toString();
+    _tracer.closeAll();
+    qCDebug(m_logCategory) << "Command latencies:" << _tracer.summary();
 
     setState(DISCONNECTED);
+    abortRequests();
 }
 
 void OpenHAB::enterStandby() {
     _flagStandby = true;
-    if (_flagSseConnected) {
-        if (_sseReply->isRunning()) {
-            _sseReply->abort();
-            QObject::disconnect(_sseReply, &QNetworkReply::readyRead, context_openHab, &OpenHAB::streamReceived);
-            _sseNetworkManager->clearConnectionCache();
-            _flagSseConnected = false;
-        }
+    saveSnapshot();
+    stopSse();
+    _sseScheduler->cancel();
+    _probeScheduler->cancel();
+    // leaveStandby() reads the items again
+    abortRequests();
+}
+
+void OpenHAB::abortRequests() {
+    // the handlers ignore replies which aren't current any more
+    if (_itemsReply != nullptr) {
+        QNetworkReply* reply = _itemsReply;
+        _itemsReply = nullptr;
+        reply->abort();
+    }
+    QSet<QNetworkReply*> resyncReplies;
+    resyncReplies.swap(_resyncReplies);
+    for (QNetworkReply* reply : qAsConst(resyncReplies)) {
+        reply->abort();
+    }
+    _resyncCorrected.clear();
+    _resyncItems = 0;
+    if (_watchdogProbe != nullptr) {
+        QNetworkReply* reply = _watchdogProbe;
+        _watchdogProbe = nullptr;
+        reply->abort();
     }
 }
 
 void OpenHAB::leaveStandby() {
     _flagStandby = false;
-    _flagleaveStandby = true;
-    getSystemInfo();
+    _probeScheduler->reset();
+    _sseScheduler->reset();
+    if (state() != CONNECTED) {
+        getSystemInfo();
+        return;
+    }
+    // fast resume: reopen the event stream and refresh only the items of this integration at the same time,
+    // a failing request triggers the connection probe
+    startSse();
+    _sseOutageStart = -1;
+    resyncItems(boundItems());
 }
 
 void OpenHAB::jsonError(const QString& error) {
+    _metrics.add(OpenHABMetrics::JSON_ERRORS);
     qCWarning(m_logCategory) << "JSON error " << error;
 }
 
@@ -400,196 +567,643 @@ void OpenHAB::onNetWorkAccessible(QNetworkAccessManager::NetworkAccessibility ac
     qCInfo(m_logCategory) << "network accessibility" << accessibility;
 }
 
-void OpenHAB::getItems() {
-    QNetworkRequest request(_url + "items");
-    request.setHeader(QNetworkRequest::KnownHeaders::ContentTypeHeader, "application/json");
-    if (_token != "") {
-        request.setRawHeader("accept", "*/*");
-        QString token = "Bearer " + _token;
-        request.setRawHeader("Authorization", token.toUtf8());
+void OpenHAB::getItems() { requestItems("items?fields=name,state,type,groupNames", true); }
+
+QNetworkReply* OpenHAB::getItemStates() { return requestItems("items?fields=name,state", false); }
+
+QNetworkReply* OpenHAB::requestItems(const QString& query, bool bootstrap) {
+    if (_itemsReply != nullptr && _itemsBootstrap && !bootstrap) {
+        // the running bootstrap already reads the states of all items
+        return nullptr;
+    }
+    if (_itemsReply != nullptr) {
+        QNetworkReply* reply = _itemsReply;
+        _itemsReply = nullptr;
+        reply->abort();
     }
-    request.setRawHeader("Accept", "application/json");
-    _nam->get(request);
+
+    if (bootstrap) {
+        // the bootstrap reads all items, there is no need to resync after an outage
+        _updater->reset();
+        _sseOutageStart = -1;
+    }
+    _itemsBootstrap = bootstrap;
+    _itemsSeen.clear();
+    _itemsReader.reset();
+    _itemsTimer.start();
+
+    QNetworkReply* reply = _nam->get(_requests.json(query));
+    _itemsReply = reply;
+    QObject::connect(reply, &QNetworkReply::readyRead, context_openHab, [this, reply]() { itemsReceived(reply); });
+    QObject::connect(reply, &QNetworkReply::finished, context_openHab, [this, reply]() { itemsFinished(reply); });
+    return reply;
 }
 
-void OpenHAB::getItem(const QString name) {
-    QNetworkRequest request(_url + "items/" + name);
-    request.setHeader(QNetworkRequest::KnownHeaders::ContentTypeHeader, "application/json");
-    if (_token != "") {
-        request.setRawHeader("accept", "*/*");
-        QString token = "Bearer " + _token;
-        request.setRawHeader("Authorization", token.toUtf8());
+void OpenHAB::itemsReceived(QNetworkReply* reply) {
+    if (reply != _itemsReply || (state() != CONNECTING && state() != CONNECTED)) {
+        return;
+    }
+    if (!_itemsReader.feed(reply->readAll())) {
+        jsonError("invalid items document");
+        _itemsReply = nullptr;
+        reply->abort();
     }
-    request.setRawHeader("Accept", "application/json");
-    _nam->get(request);
 }
-void OpenHAB::processItem(const QJsonDocument& result) {
-    QJsonObject json = result.object();
 
-    for (int i = 0; i < _myEntities.size(); ++i) {
-        if (json.value("name") == _myEntities[i]->entity_id()) {
-            processEntity(json, _myEntities[i]);
+void OpenHAB::itemsFinished(QNetworkReply* reply) {
+    reply->deleteLater();
+    if (reply != _itemsReply) {
+        return;
+    }
+    _itemsReply = nullptr;
+    if (state() != CONNECTING && state() != CONNECTED) {
+        return;
+    }
+
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (reply->error() != QNetworkReply::NoError || httpStatus != 200) {
+        onProbeFailed(httpStatus);
+        return;
+    }
+    onProbeSucceeded();
+    if (!_itemsReader.feed(reply->readAll()) || !_itemsReader.isComplete()) {
+        jsonError("incomplete items document");
+        return;
+    }
+    _metrics.record(OpenHABMetrics::ITEMS_READ, _itemsTimer.elapsed());
+    qCInfo(m_logCategory) << "Read" << _itemsReader.itemCount() << "openHAB items in" << _itemsTimer.elapsed()
+                          << "ms, peak buffer" << _itemsReader.peakBufferSize() << "bytes";
+
+    if (_itemsBootstrap) {
+        // entities stay connected while the items are read, e.g. with the states of the snapshot
+        for (EntityInterface* entity : _myEntities) {
+            if (!_itemsSeen.contains(entity) && _updater->isConnected(entity)) {
+                _updater->setConnected(entity, false);
+            }
         }
+        int missing = _myEntities.count() - _itemsSeen.size();
+        if (missing > 0) {
+            m_notifications->add(true, "Could not load : " + QString::number(missing) + "openHAB items");
+        }
+        setState(CONNECTED);
     }
 }
-void OpenHAB::processItems(const QJsonDocument& result, bool first) {
-    int        countFound = 0, countAll = 0;
-    QJsonArray array = result.array();
 
-    qCDebug(m_logCategory) << array.size();
+void OpenHAB::onItemRead(const OpenHABItemsReader::Item& item) {
+    if (state() != CONNECTING && state() != CONNECTED) {
+        return;
+    }
+    auto binding = _entityIndex.find(QString::fromUtf8(item.name));
+    if (binding == _entityIndex.end()) {
+        return;
+    }
+    checkResyncValue(*binding, item.state);
+    binding->lastValue = QByteArray(item.state.constData(), item.state.size());
+    // the resync only reads the states
+    if (!item.type.isEmpty() && binding->itemType != item.type) {
+        binding->itemType = QByteArray(item.type.constData(), item.type.size());
+    }
+    if (_itemsBootstrap && !_itemsSeen.contains(binding->entity)) {
+        // entities of openHAB things have several items, count the entities
+        _itemsSeen.insert(binding->entity);
+        if (!_updater->isConnected(binding->entity)) {
+            _updater->setConnected(binding->entity, true);
+        }
+    }
+    processState(*binding, OpenHABStateParser::parse(item.state, binding->itemType));
+}
+
+void OpenHAB::resyncItems(const QStringList& items) {
+    if (items.isEmpty()) {
+        return;
+    }
+    QList<QNetworkReply*> replies;
 
-    if (first) {
-        for (int i = 0; i < _myEntities.size(); ++i) {
-            _myEntities[i]->setConnected(false);
+    // openHAB can't filter items by name: few items are requested one by one, otherwise the states of all items
+    if (items.size() <= MAX_PARALLEL_ITEM_REQUESTS) {
+        for (const QString& item : items) {
+            replies.append(getItem(item));
         }
-        for (int i = 0; i < _myEntities.size(); ++i) {
-            for (QJsonArray::iterator j = array.begin(); j != array.end(); ++j) {
-                QJsonObject item = j->toObject();
-                QString     name = item.value("name").toString();
-                countAll++;
-                if (name == _myEntities[i]->entity_id()) {
-                    countFound++;
-                    _myEntities[i]->setConnected(true);
-                    qCDebug(m_logCategory) << _myEntities[i]->entity_id() + "connected:" + _myEntities[i]->connected();
-                    processEntity(item, _myEntities[i]);
-                }
+    } else {
+        QNetworkReply* reply = getItemStates();
+        if (reply == nullptr) {
+            return;
+        }
+        replies.append(reply);
+    }
+
+    // count the entities which had a wrong state, the replies are processed before this handler is called
+    if (_resyncReplies.isEmpty()) {
+        _resyncCorrected.clear();
+        _resyncItems = 0;
+    }
+    _resyncItems += items.size();
+    for (QNetworkReply* reply : replies) {
+        _resyncReplies.insert(reply);
+        QObject::connect(reply, &QNetworkReply::finished, context_openHab, [this, reply]() {
+            if (_resyncReplies.remove(reply) && _resyncReplies.isEmpty()) {
+                resyncFinished();
             }
+        });
+    }
+}
+
+void OpenHAB::resyncFinished() {
+    _metrics.add(OpenHABMetrics::RESYNC_ITEMS, _resyncItems);
+    _metrics.add(OpenHABMetrics::RESYNC_CORRECTED, _resyncCorrected.size());
+    qCInfo(m_logCategory) << "Resync of" << _resyncItems << "items corrected" << _resyncCorrected.size() << "entities";
+    _resyncCorrected.clear();
+    _resyncItems = 0;
+}
+
+void OpenHAB::checkResyncValue(const ItemBinding& binding, const QByteArray& value) {
+    if (!_resyncReplies.isEmpty() && binding.lastValue != value) {
+        _resyncCorrected.insert(binding.entity);
+    }
+}
+
+QNetworkReply* OpenHAB::getItem(const QString name) {
+    QNetworkReply* reply = _nam->get(_requests.json("items/" + name));
+    QObject::connect(reply, &QNetworkReply::finished, context_openHab, [this, reply]() { onItemReply(reply); });
+    return reply;
+}
+
+void OpenHAB::getThings() {
+    QNetworkReply* reply = _nam->get(_requests.json("things"));
+    QObject::connect(reply, &QNetworkReply::finished, context_openHab, [this, reply]() { onThingsReply(reply); });
+}
+
+template <typename Attribute>
+bool OpenHAB::matchThing(const QJsonObject& thing, const QMap<QString, Attribute>& channels,
+                         const QList<Attribute>& mandatory, int channelcount, ThingBinding* binding) {
+    for (const QJsonValue& value : thing.value("channels").toArray()) {
+        QJsonObject channel = value.toObject();
+        QJsonArray  linkedItems = channel.value("linkedItems").toArray();
+        // channels of a channel group are named "<group>#<channel>"
+        QString id = channel.value("id").toString().section('#', -1);
+        auto    attribute = channels.constFind(id);
+
+        if (attribute == channels.constEnd() || linkedItems.isEmpty()) {
+            continue;
+        }
+        QString item = linkedItems.first().toString();
+        binding->channels.insert(id, item);
+        binding->items.insert(item, *attribute);
+        if (!binding->attributes.contains(*attribute)) {
+            binding->attributes.insert(*attribute, item);
+        }
+    }
+
+    int additional = binding->attributes.size();
+    for (Attribute attribute : mandatory) {
+        if (!binding->attributes.contains(attribute)) {
+            return false;
         }
-        if ((_myEntities.count() - countFound) > 0) {
-            m_notifications->add(
-                true, "Could not load : " + QString::number((_myEntities.count() - countFound)) + "openHAB items");
+        additional--;
+    }
+    return additional >= channelcount;
+}
+
+void OpenHAB::onThingsReply(QNetworkReply* reply) {
+    reply->deleteLater();
+    if (state() != CONNECTING) {
+        return;
+    }
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (httpStatus == 0) {
+        onProbeFailed(httpStatus);
+        return;
+    }
+
+    QJsonParseError parseerror;
+    QJsonDocument   doc;
+    if (httpStatus == 200) {
+        doc = QJsonDocument::fromJson(reply->readAll(), &parseerror);
+        if (parseerror.error != QJsonParseError::NoError) {
+            jsonError(parseerror.errorString());
         }
     } else {
-        for (int i = 0; i < _myEntities.size(); ++i) {
-            for (QJsonArray::iterator j = array.begin(); j != array.end(); ++j) {
-                QJsonObject item = j->toObject();
-                QString     name = item.value("name").toString();
-                countAll++;
-                if (name == _myEntities[i]->entity_id()) {
-                    countFound++;
-                    processEntity(item, _myEntities[i]);
-                } else {
-                    // _myEntities.removeAt(i);
-                }
+        qCWarning(m_logCategory) << "Cannot read openHAB things, status" << httpStatus;
+    }
+
+    // the bindings restored from the snapshot are replaced by the current things
+    for (auto i = _entityIndex.begin(); i != _entityIndex.end();) {
+        if (i->attribute >= 0) {
+            i = _entityIndex.erase(i);
+        } else {
+            ++i;
+        }
+    }
+    _thingBindings.clear();
+
+    // entities without a matching thing are reported as not loaded by the items request
+    for (const QJsonValue& value : doc.array()) {
+        QJsonObject      thing = value.toObject();
+        QString          uid = thing.value("UID").toString();
+        EntityInterface* entity = _thingEntities.value(uid);
+        ThingBinding     binding;
+
+        if (entity == nullptr) {
+            // help the user with the configuration of things which can be used
+            if (matchThing(thing, MediaPlayerChannels::channels, MediaPlayerChannels::mandatory,
+                           MediaPlayerChannels::channelcount, &binding)) {
+                qCInfo(m_logCategory) << "openHAB thing" << uid << thing.value("label").toString()
+                                      << "can be added as media player";
             }
+        } else if (entity->type() == "media_player" &&
+                   matchThing(thing, MediaPlayerChannels::channels, MediaPlayerChannels::mandatory,
+                              MediaPlayerChannels::channelcount, &binding)) {
+            bindThing(entity, binding, &OpenHAB::handleMediaPlayerState);
+        } else if (entity->type() == "light" && matchThing(thing, LightChannels::channels, LightChannels::mandatory,
+                                                           LightChannels::channelcount, &binding)) {
+            bindThing(entity, binding, &OpenHAB::handleComplexLightState);
+        } else {
+            qCWarning(m_logCategory) << "openHAB thing" << uid << "doesn't provide the channels for a"
+                                     << entity->type();
         }
     }
+    updateEventFilter();
+
+    startSse();
+    getItems();
+}
+
+void OpenHAB::bindThing(EntityInterface* entity, const ThingBinding& thing, StateHandler handler) {
+    ItemBinding binding;
+
+    binding.entity = entity;
+    binding.features = entityFeatures(entity);
+    binding.handler = handler;
+    for (auto i = thing.items.constBegin(); i != thing.items.constEnd(); ++i) {
+        binding.attribute = i.value();
+        _entityIndex.insert(i.key(), binding);
+    }
+    _thingBindings.insert(entity->entity_id(), thing);
 }
 
-void OpenHAB::processEntity(const QJsonObject& item, EntityInterface* entity) {
-    Q_ASSERT(entity != nullptr);
+const QString* OpenHAB::lookupThingChannel(const QString& entityId, const QString& channel) {
+    auto thing = _thingBindings.constFind(entityId);
+    if (thing == _thingBindings.constEnd()) {
+        return nullptr;
+    }
+    auto item = thing->channels.constFind(channel);
+    return item == thing->channels.constEnd() ? nullptr : &item.value();
+}
+
+const QString* OpenHAB::lookupPlayerItem(const QString& entityId, MediaPlayerDef::Attributes attr) {
+    return lookupThingItem(entityId, attr);
+}
+
+const QString* OpenHAB::lookupComplexLightItem(const QString& entityId, LightDef::Attributes attr) {
+    return lookupThingItem(entityId, attr);
+}
 
-    if (entity->connected()) {
-        if (entity->type() == "light" && entity->supported_features().contains("BRIGHTNESS") &&
-            _brightnessValueTemplate.exactMatch(item.value("state").toString())) {
-            processLight(item.value("state").toString(), entity, true);
+const QString* OpenHAB::lookupThingItem(const QString& entityId, int attr) {
+    auto thing = _thingBindings.constFind(entityId);
+    if (thing == _thingBindings.constEnd()) {
+        return nullptr;
+    }
+    auto item = thing->attributes.constFind(attr);
+    return item == thing->attributes.constEnd() ? nullptr : &item.value();
+}
+
+QString OpenHAB::snapshotPath() const {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/openhab-" + integrationId() +
+           ".snapshot";
+}
+
+void OpenHAB::saveSnapshot() {
+    if (_snapshotMaxAge <= 0 || _entityIndex.isEmpty()) {
+        return;
+    }
+    QVector<OpenHABSnapshot::Record> records;
+    records.reserve(_entityIndex.size());
+    for (auto i = _entityIndex.constBegin(); i != _entityIndex.constEnd(); ++i) {
+        if (i->handler == nullptr) {
+            continue;
+        }
+        OpenHABSnapshot::Record record;
+        record.item = i.key();
+        record.entityId = i->entity->entity_id();
+        record.attribute = i->attribute;
+        if (i->attribute >= 0) {
+            record.channel = _thingBindings.value(record.entityId).channels.key(i.key());
         }
-        if (entity->type() == "light" && entity->supported_features().contains("COLOR") &&
-            _colorValueTemplate.exactMatch(item.value("state").toString())) {
-            processComplexLight(item.value("state").toString(), entity);
+        record.state = i->lastValue;
+        record.type = i->itemType;
+        records.append(record);
+    }
+    if (!OpenHABSnapshot::write(snapshotPath(), _url, records)) {
+        qCWarning(m_logCategory) << "Cannot write the state snapshot" << snapshotPath();
+    }
+}
+
+void OpenHAB::loadSnapshot() {
+    QVector<OpenHABSnapshot::Record> records;
+    QElapsedTimer                    timer;
+
+    timer.start();
+    if (_snapshotMaxAge <= 0 || !OpenHABSnapshot::read(snapshotPath(), _url, _snapshotMaxAge, &records)) {
+        return;
+    }
+
+    // restore the items of thing based entities, the things are read again when openHAB is reachable
+    QHash<QString, ThingBinding> things;
+    for (const OpenHABSnapshot::Record& record : qAsConst(records)) {
+        if (record.attribute >= 0 && _thingEntities.contains(record.entityId)) {
+            ThingBinding& thing = things[record.entityId];
+            thing.channels.insert(record.channel, record.item);
+            thing.items.insert(record.item, record.attribute);
+            if (!thing.attributes.contains(record.attribute)) {
+                thing.attributes.insert(record.attribute, record.item);
+            }
         }
-        if (entity->type() == "light") {
-            processLight(item.value("state").toString(), entity, false);
+    }
+    for (auto i = things.constBegin(); i != things.constEnd(); ++i) {
+        EntityInterface* entity = _thingEntities.value(i.key());
+        if (entity->type() == "media_player") {
+            bindThing(entity, *i, &OpenHAB::handleMediaPlayerState);
+        } else {
+            bindThing(entity, *i, &OpenHAB::handleComplexLightState);
         }
+    }
+    updateEventFilter();
 
-        if (entity->type() == "switch") {
-            processSwitch(item.value("state").toString(), entity);
+    int restored = 0;
+    for (const OpenHABSnapshot::Record& record : qAsConst(records)) {
+        auto binding = _entityIndex.find(record.item);
+        if (binding == _entityIndex.end() || binding->entity->entity_id() != record.entityId ||
+            record.state.isEmpty()) {
+            continue;
+        }
+        binding->lastValue = record.state;
+        binding->itemType = record.type;
+        if (!_updater->isConnected(binding->entity)) {
+            _updater->setConnected(binding->entity, true);
         }
-        if (entity->type() == "blind") {
-            processBlind(item.value("state").toString(), entity);
+        processState(*binding, OpenHABStateParser::parse(binding->lastValue, binding->itemType));
+        restored++;
+    }
+    qCInfo(m_logCategory) << "Restored" << restored << "item states from the snapshot in" << timer.elapsed() << "ms";
+}
+
+void OpenHAB::buildEntityIndex() {
+    _entityIndex.clear();
+    _entityIndex.reserve(_myEntities.size());
+    _thingEntities.clear();
+    _thingBindings.clear();
+    for (EntityInterface* entity : _myEntities) {
+        // item names can't contain a colon, thing UIDs always do
+        if (entity->type() == "media_player" || (entity->type() == "light" && entity->entity_id().contains(':'))) {
+            // the entity id is the UID of an openHAB thing, its items are bound when the things are read
+            _thingEntities.insert(entity->entity_id(), entity);
+        } else {
+            _entityIndex.insert(entity->entity_id(), bindEntity(entity));
         }
+    }
+    updateEventFilter();
+}
+
+void OpenHAB::updateEventFilter() {
+    QStringList topics;
+
+    _itemFilter.clear();
+    _itemFilter.reserve(_entityIndex.size());
+    for (auto i = _entityIndex.constBegin(); i != _entityIndex.constEnd(); ++i) {
+        _itemFilter.insert(i.key().toLatin1());
+        // namespace is "smarthome" for openHAB 2 and "openhab" for openHAB 3
+        topics.append(_stateChangedEvents ? "*/items/" + i.key() + "/*statechanged" : "*/items/" + i.key() + "/*");
+    }
+
+    // let openHAB filter the events, unless the URL would get too long for the server
+    _sseTopics = topics.join(',');
+    if (_sseTopics.size() > MAX_TOPIC_FILTER_LENGTH) {
+        qCInfo(m_logCategory) << "Too many items for a server side event filter, filtering" << topics.size()
+                              << "items locally";
+        _sseTopics.clear();
+    }
+}
+
+OpenHAB::ItemBinding OpenHAB::bindEntity(EntityInterface* entity) {
+    ItemBinding binding;
+    QString     type = entity->type();
+
+    binding.entity = entity;
+    binding.features = entityFeatures(entity);
+    if (type == "light") {
+        binding.handler = &OpenHAB::handleLightState;
+    } else if (type == "blind") {
+        binding.handler = &OpenHAB::handleBlindState;
+    } else if (type == "switch") {
+        binding.handler = &OpenHAB::handleSwitchState;
     } else {
-        qCDebug(m_logCategory) << QString("Entity %s is offline").arg(entity->entity_id());
+        qCInfo(m_logCategory) << "Entity type" << type << "of" << entity->entity_id() << "is not supported";
     }
+    return binding;
 }
 
-void OpenHAB::processLight(const QString& value, EntityInterface* entity, bool isDimmer) {
-    if (entity == nullptr) return;
-    if (!(value.contains("ON")) && !(value.contains("OFF")) && isDimmer) {
-        entity->setState(value.toInt() > 0 ? LightDef::ON : LightDef::OFF);
+int OpenHAB::entityFeatures(EntityInterface* entity) {
+    QString type = entity->type();
+    int     features = 0;
+
+    if (type == "light") {
         if (entity->isSupported(LightDef::F_BRIGHTNESS)) {
-            entity->updateAttrByIndex(LightDef::BRIGHTNESS, value);
-        } else {
-            qCDebug(m_logCategory) << QString("OpenHab Dimmer %1 not supporting BRIGHTNESS").arg(entity->entity_id());
+            features |= FEATURE_BRIGHTNESS;
+        }
+        if (entity->isSupported(LightDef::F_COLOR)) {
+            features |= FEATURE_COLOR;
+        }
+        if (entity->isSupported(LightDef::F_COLORTEMP)) {
+            features |= FEATURE_COLORTEMP;
+        }
+    } else if (type == "blind") {
+        if (entity->isSupported(BlindDef::F_POSITION)) {
+            features |= FEATURE_POSITION;
         }
+    }
+    return features;
+}
+
+void OpenHAB::processItem(const QJsonDocument& result) {
+    QJsonObject json = result.object();
+    auto        binding = _entityIndex.find(json.value("name").toString());
+
+    if (binding != _entityIndex.end()) {
+        QString    state = json.value("state").toString();
+        QByteArray value = state.toUtf8();
+        checkResyncValue(*binding, value);
+        binding->lastValue = value;
+        binding->itemType = json.value("type").toString().toUtf8();
+        processState(*binding, OpenHABStateParser::parse(state, binding->itemType));
+    }
+}
+
+void OpenHAB::processState(const ItemBinding& binding, const OpenHABState& state) {
+    if (binding.handler == nullptr) {
+        return;
+    }
+    if (!_updater->isConnected(binding.entity)) {
+        qCDebug(m_logCategory) << QString("Entity %1 is offline").arg(binding.entity->entity_id());
+        return;
+    }
+    // openHAB doesn't send the item type in the status update, the handler was selected by the entity type
+    if (!state.isUndefined()) {
+        (this->*binding.handler)(state, binding);
+    }
+}
+
+void OpenHAB::handleLightState(const OpenHABState& state, const ItemBinding& binding) {
+    if ((binding.features & FEATURE_BRIGHTNESS) && state.type == OpenHABState::PERCENT) {
+        processLight(state, binding, true);
+    } else if ((binding.features & FEATURE_COLOR) && state.type == OpenHABState::HSB) {
+        processComplexLight(state, binding, LightDef::COLOR);
     } else {
-        if (value.toUpper() == "ON") {
-            entity->setState(LightDef::ON);
-        } else if (value.toUpper() == "OFF") {
-            entity->setState(LightDef::OFF);
+        processLight(state, binding, false);
+    }
+}
+
+void OpenHAB::handleComplexLightState(const OpenHABState& state, const ItemBinding& binding) {
+    processComplexLight(state, binding, static_cast<LightDef::Attributes>(binding.attribute));
+}
+
+void OpenHAB::handleBlindState(const OpenHABState& state, const ItemBinding& binding) {
+    processBlind(state, binding);
+}
+
+void OpenHAB::handleSwitchState(const OpenHABState& state, const ItemBinding& binding) {
+    processSwitch(state, binding.entity);
+}
+
+void OpenHAB::handleMediaPlayerState(const OpenHABState& state, const ItemBinding& binding) {
+    processPlayerItem(state, binding.entity, static_cast<MediaPlayerDef::Attributes>(binding.attribute));
+}
+
+void OpenHAB::processLight(const OpenHABState& state, const ItemBinding& binding, bool isDimmer) {
+    EntityInterface* entity = binding.entity;
+    if (entity == nullptr) return;
+    if (state.type == OpenHABState::PERCENT && isDimmer) {
+        int brightness = qRound(state.number);
+        _updater->setState(entity, brightness > 0 ? LightDef::ON : LightDef::OFF);
+        if (binding.features & FEATURE_BRIGHTNESS) {
+            _updater->updateAttribute(entity, LightDef::BRIGHTNESS, brightness);
         } else {
-            qCDebug(m_logCategory)
-                << QString("OpenHab Switch %1 undefined state %2").arg(entity->entity_id()).arg(value.toUpper());
+            qCDebug(m_logCategory) << QString("OpenHab Dimmer %1 not supporting BRIGHTNESS").arg(entity->entity_id());
         }
+    } else if (state.type == OpenHABState::ON_OFF) {
+        _updater->setState(entity, state.on ? LightDef::ON : LightDef::OFF);
+    } else {
+        qCDebug(m_logCategory)
+            << QString("OpenHab Switch %1 undefined state %2").arg(entity->entity_id()).arg(state.toString());
     }
 }
 
-void OpenHAB::processBlind(const QString& value, EntityInterface* entity) {
+void OpenHAB::processBlind(const OpenHABState& state, const ItemBinding& binding) {
+    EntityInterface* entity = binding.entity;
     if (entity == nullptr) return;
-    QString state = value.toUpper();
-    bool    ok = false;
-    int     pos = state.toInt(&ok, 10);
-    if (ok && entity->isSupported(BlindDef::F_POSITION)) {
-        entity->updateAttrByIndex(BlindDef::POSITION, pos);
-        entity->setState(pos == 100 ? BlindDef::OPEN : BlindDef::CLOSED);
-    } else if (state == "ON") {
-        entity->setState(BlindDef::OPEN);
-    } else if (state == "OFF") {
-        entity->setState(BlindDef::CLOSED);
+    if (state.isNumber() && (binding.features & FEATURE_POSITION)) {
+        // rollershutters report how far they are closed, UP is 0%: the remote shows how far the blind is open
+        int pos = 100 - qBound(0, qRound(state.number), 100);
+        _updater->updateAttribute(entity, BlindDef::POSITION, pos);
+        _updater->setState(entity, pos == 100 ? BlindDef::OPEN : BlindDef::CLOSED);
+    } else if (state.type == OpenHABState::ON_OFF || state.type == OpenHABState::UP_DOWN) {
+        _updater->setState(entity, state.on ? BlindDef::OPEN : BlindDef::CLOSED);
     }
 }
 
-void OpenHAB::processSwitch(const QString& value, EntityInterface* entity) {
+void OpenHAB::processSwitch(const OpenHABState& state, EntityInterface* entity) {
     if (entity == nullptr) return;
-    QString state = value.toUpper();
-    if (state == "ON") {
-        entity->setState(SwitchDef::ON);
+    if (state.type == OpenHABState::ON_OFF && state.on) {
+        _updater->setState(entity, SwitchDef::ON);
     } else {
-        entity->setState(SwitchDef::OFF);
+        _updater->setState(entity, SwitchDef::OFF);
     }
 }
 
-void OpenHAB::processComplexLight(const QString& value, EntityInterface* entity) {
+void OpenHAB::processComplexLight(const OpenHABState& state, const ItemBinding& binding, LightDef::Attributes attr) {
+    EntityInterface* entity = binding.entity;
     if (entity == nullptr) return;
-    if (entity->supported_features().contains("COLOR")) {
-        if (_colorValueTemplate.exactMatch(value)) {
-            QStringList cs = value.split(',');
-            QColor      color =
-                QColor((cs[0].toInt()), ((cs[1].toInt() * 255) / 100), ((cs[2].toInt() * 255) / 100), QColor::Hsl);
-            char buffer[10];
-            snprintf(buffer, sizeof(buffer), "#%02X%02X%02X", color.red(), color.green(), color.blue());
-            entity->updateAttrByIndex(LightDef::COLOR, buffer);
-        } else if (_brightnessValueTemplate.exactMatch(value) && entity->supported_features().contains("BRIGHTNESS")) {
-            int  brightness = value.toInt();
-            bool on = brightness == 100;
-            entity->setState(on ? LightDef::ON : LightDef::OFF);
-            entity->updateAttrByIndex(LightDef::BRIGHTNESS, brightness);
-        } else if (value.contains("ON") || value.contains("OFF")) {
-            if (value.toUpper() == "ON") {
-                entity->setState(LightDef::ON);
-            } else if (value.toUpper() == "OFF") {
-                entity->setState(LightDef::OFF);
-            } else {
-                qCInfo(m_logCategory) << "Wrong or not supported Color/Brightness command for " << entity->entity_id();
-            }
-        } else {
-            qCInfo(m_logCategory) << "Wrong or not supported Color/Brightness command for " << entity->entity_id();
+    if (state.type == OpenHABState::ON_OFF && attr != LightDef::COLORTEMP) {
+        _updater->setState(entity, state.on ? LightDef::ON : LightDef::OFF);
+    } else if (attr == LightDef::COLOR && state.type == OpenHABState::HSB && (binding.features & FEATURE_COLOR)) {
+        QColor color = QColor::fromHsv(qBound(0, qRound(state.hue), 359), qRound(state.saturation * 255 / 100),
+                                       qRound(state.brightness * 255 / 100));
+        char   buffer[10];
+        snprintf(buffer, sizeof(buffer), "#%02X%02X%02X", color.red(), color.green(), color.blue());
+        _updater->setState(entity, state.brightness > 0 ? LightDef::ON : LightDef::OFF);
+        _updater->updateAttribute(entity, LightDef::COLOR, buffer);
+        if (binding.features & FEATURE_BRIGHTNESS) {
+            _updater->updateAttribute(entity, LightDef::BRIGHTNESS, qRound(state.brightness));
+        }
+    } else if (attr != LightDef::COLORTEMP && state.type == OpenHABState::PERCENT) {
+        // brightness items and color items which only changed the brightness
+        int brightness = qRound(state.number);
+        _updater->setState(entity, brightness > 0 ? LightDef::ON : LightDef::OFF);
+        if (binding.features & FEATURE_BRIGHTNESS) {
+            _updater->updateAttribute(entity, LightDef::BRIGHTNESS, brightness);
         }
-    } else if (entity->supported_features().contains("COLORTEMP")) {
-        int colortemp = value.toInt();
-        entity->updateAttrByIndex(LightDef::COLORTEMP, colortemp);
+    } else if (attr == LightDef::COLORTEMP && state.isNumber() && (binding.features & FEATURE_COLORTEMP)) {
+        _updater->updateAttribute(entity, LightDef::COLORTEMP, qRound(state.number));
     } else {
-        qCInfo(m_logCategory) << "Not supported Color/Brightness/Colortemp command for " << entity->entity_id();
+        qCInfo(m_logCategory) << "Not supported state" << state.toString() << "of light attribute" << attr << "for"
+                              << entity->entity_id();
+    }
+}
+
+void OpenHAB::processPlayerItem(const OpenHABState& state, EntityInterface* entity,
+                                MediaPlayerDef::Attributes attr) {
+    switch (attr) {
+        case MediaPlayerDef::STATE:
+            // "power" is a switch, "control" and "state" report the playback
+            if (state.type == OpenHABState::ON_OFF) {
+                _updater->setState(entity, state.on ? MediaPlayerDef::ON : MediaPlayerDef::OFF);
+            } else {
+                QString playback = state.toString().toUpper();
+                if (playback == "PLAY" || playback == "PLAYING") {
+                    _updater->setState(entity, MediaPlayerDef::PLAYING);
+                } else if (playback == "PAUSE" || playback == "PAUSED" || playback == "STOP" || playback == "STOPPED") {
+                    _updater->setState(entity, MediaPlayerDef::IDLE);
+                }
+            }
+            break;
+        case MediaPlayerDef::VOLUME:
+        case MediaPlayerDef::MEDIAPROGRESS:
+        case MediaPlayerDef::MEDIADURATION:
+            if (state.isNumber()) {
+                _updater->updateAttribute(entity, attr, qRound(state.number));
+            }
+            break;
+        case MediaPlayerDef::MUTED:
+            if (state.type == OpenHABState::ON_OFF) {
+                _updater->updateAttribute(entity, attr, state.on);
+            }
+            break;
+        case MediaPlayerDef::SOURCE:
+        case MediaPlayerDef::MEDIAARTIST:
+        case MediaPlayerDef::MEDIATITLE:
+            _updater->updateAttribute(entity, attr, state.toString());
+            break;
+        default:
+            qCDebug(m_logCategory) << "Media player attribute" << attr << "not supported for" << entity->entity_id();
+            break;
     }
 }
 
 void OpenHAB::sendCommand(const QString& type, const QString& entityId, int command, const QVariant& param) {
-    QString      state;
-    QColor       color;
+    if (QThread::currentThread() != thread()) {
+        // called by the entities on the main thread, the network objects belong to the integration thread
+        QMetaObject::invokeMethod(
+            this, [this, type, entityId, command, param]() { sendCommand(type, entityId, command, param); },
+            Qt::QueuedConnection);
+        return;
+    }
+    QString        state;
+    const QString* item = &entityId;
+    QColor         color;
     QVariantMap  data;
     QVariantList list;
 
     if (type == "light") {
+        LightDef::Attributes attr = LightDef::BRIGHTNESS;
         switch (static_cast<LightDef::Commands>(command)) {
             case LightDef::C_OFF:
                 state = "OFF";
@@ -601,14 +1215,35 @@ void OpenHAB::sendCommand(const QString& type, const QString& entityId, int comm
                 state = QString::number(param.toInt());
                 break;
             case LightDef::C_COLOR:
+                // openHAB color items take HSB: hue in degrees, saturation and brightness in percent
                 color = QColor(param.toString());
-                state = QString::number(color.hue()) + ',' + QString::number(color.saturationF() * 100) + ',' +
-                        QString::number(color.lightnessF() * 100);
+                state = QString::number(qMax(0, color.hsvHue())) + ',' +
+                        QString::number(qRound(color.hsvSaturationF() * 100)) + ',' +
+                        QString::number(qRound(color.valueF() * 100));
+                attr = LightDef::COLOR;
+                break;
+            case LightDef::C_COLORTEMP:
+                state = QString::number(param.toInt());
+                attr = LightDef::COLORTEMP;
                 break;
             default:
                 qCInfo(m_logCategory) << "Light command" << command << " not supported for " << entityId;
                 return;
         }
+        if (_thingBindings.contains(entityId)) {
+            // color items also take ON/OFF and a brightness, for things without a brightness channel
+            item = lookupComplexLightItem(entityId, attr);
+            if (item == nullptr && attr == LightDef::BRIGHTNESS) {
+                item = lookupComplexLightItem(entityId, LightDef::COLOR);
+            }
+            if (item == nullptr) {
+                qCInfo(m_logCategory) << "No openHAB item for light command" << command << "of" << entityId;
+                return;
+            }
+        } else if (attr == LightDef::COLORTEMP) {
+            qCInfo(m_logCategory) << "Light command" << command << " not supported for " << entityId;
+            return;
+        }
     } else if (type == "switch") {
         switch (static_cast<SwitchDef::Commands>(command)) {
             case SwitchDef::C_OFF:
@@ -621,32 +1256,194 @@ void OpenHAB::sendCommand(const QString& type, const QString& entityId, int comm
                 qCInfo(m_logCategory) << "Light command" << command << " not supported for " << entityId;
                 return;
         }
+    } else if (type == "media_player") {
+        switch (static_cast<MediaPlayerDef::Commands>(command)) {
+            case MediaPlayerDef::C_TURNON:
+            case MediaPlayerDef::C_TURNOFF:
+                item = lookupThingChannel(entityId, "power");
+                state = command == MediaPlayerDef::C_TURNON ? "ON" : "OFF";
+                break;
+            case MediaPlayerDef::C_PLAY:
+                item = lookupThingChannel(entityId, "control");
+                state = "PLAY";
+                break;
+            case MediaPlayerDef::C_PAUSE:
+            case MediaPlayerDef::C_STOP:
+                item = lookupThingChannel(entityId, "control");
+                state = "PAUSE";
+                break;
+            case MediaPlayerDef::C_NEXT:
+                item = lookupThingChannel(entityId, "control");
+                state = "NEXT";
+                break;
+            case MediaPlayerDef::C_PREVIOUS:
+                item = lookupThingChannel(entityId, "control");
+                state = "PREVIOUS";
+                break;
+            case MediaPlayerDef::C_VOLUME_SET:
+                item = lookupPlayerItem(entityId, MediaPlayerDef::VOLUME);
+                state = QString::number(param.toInt());
+                break;
+            case MediaPlayerDef::C_VOLUME_UP:
+                item = lookupPlayerItem(entityId, MediaPlayerDef::VOLUME);
+                state = "INCREASE";
+                break;
+            case MediaPlayerDef::C_VOLUME_DOWN:
+                item = lookupPlayerItem(entityId, MediaPlayerDef::VOLUME);
+                state = "DECREASE";
+                break;
+            case MediaPlayerDef::C_MUTE:
+                item = lookupPlayerItem(entityId, MediaPlayerDef::MUTED);
+                state = param.toBool() ? "ON" : "OFF";
+                break;
+            default:
+                qCInfo(m_logCategory) << "Media player command" << command << " not supported for " << entityId;
+                return;
+        }
+        if (item == nullptr) {
+            qCInfo(m_logCategory) << "No openHAB item for media player command" << command << "of" << entityId;
+            return;
+        }
+    } else if (type == "blind") {
+        switch (static_cast<BlindDef::Commands>(command)) {
+            case BlindDef::C_OPEN:
+                state = "UP";
+                break;
+            case BlindDef::C_CLOSE:
+                state = "DOWN";
+                break;
+            case BlindDef::C_STOP:
+                state = "STOP";
+                break;
+            case BlindDef::C_POSITION:
+                // inverse of processBlind, slider drags are coalesced by the command queue
+                state = QString::number(100 - qBound(0, param.toInt(), 100));
+                break;
+            default:
+                qCInfo(m_logCategory) << "Blind command" << command << " not supported for " << entityId;
+                return;
+        }
     } else {
         qCInfo(m_logCategory) << "Command" << command << " not supported for " << entityId;
+        return;
+    }
+    qCDebug(m_logCategory) << "Command" << command << " - " << state << " for " << *item;
+    if (_optimistic && !state.isEmpty()) {
+        applyOptimisticState(*item, state);
     }
-    qCDebug(m_logCategory) << "Command" << command << " - " << state << " for " << entityId;
-    sendOpenHABCommand(entityId, state);
+    sendOpenHABCommand(*item, state);
 }
 
-void OpenHAB::sendOpenHABCommand(const QString& itemId, const QString& state) {
-    QNetworkRequest request(_url + "items/" + itemId);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "text/plain");
-    if (_token != "") {
-        request.setRawHeader("accept", "*/*");
-        QString token = "Bearer " + _token;
-        request.setRawHeader("Authorization", token.toUtf8());
+QVariantMap OpenHAB::metrics() {
+    if (QThread::currentThread() != thread()) {
+        // the metrics are only written on the integration thread
+        QVariantMap result;
+        QMetaObject::invokeMethod(
+            this, [this, &result]() { result = metrics(); }, Qt::BlockingQueuedConnection);
+        return result;
+    }
+    collectMetrics();
+    QVariantMap result = _metrics.toVariantMap();
+    result.insert("commandLatency", _tracer.summary());
+    return result;
+}
+
+void OpenHAB::collectMetrics() {
+    // counted by the command queue and the entity updater themselves
+    _metrics.set(OpenHABMetrics::COMMANDS_COALESCED, _commandQueue->coalesced());
+    _metrics.set(OpenHABMetrics::COMMANDS_DROPPED, _commandQueue->dropped());
+    _metrics.set(OpenHABMetrics::UPDATES_APPLIED, _updater->applied());
+    _metrics.set(OpenHABMetrics::UPDATES_COALESCED, _updater->coalesced());
+    _metrics.set(OpenHABMetrics::UPDATES_SUPPRESSED, _updater->suppressed());
+}
+
+void OpenHAB::applyOptimisticState(const QString& itemId, const QString& state) {
+    auto binding = _entityIndex.constFind(itemId);
+    if (binding == _entityIndex.constEnd()) {
+        return;
     }
+    processState(*binding, OpenHABStateParser::parse(state, binding->itemType));
+
+    // a newer command for the same item replaces the previous expectation
+    Expectation& expectation = _expectations[itemId];
+    expectation.state = state;
+    expectation.deadline = _clock.elapsed() + _optimisticTimeout;
+    if (!_expectationTimer->isActive()) {
+        _expectationTimer->start(_optimisticTimeout);
+    }
+}
+
+void OpenHAB::reconcileState(const QString& itemId, const OpenHABState& state) {
+    auto expectation = _expectations.find(itemId);
+    if (expectation == _expectations.end()) {
+        return;
+    }
+    if (!sameState(OpenHABStateParser::parse(expectation->state, _entityIndex.value(itemId).itemType), state)) {
+        // echo of an older command or an intermediate state while the item moves: showing it would make the entity
+        // jump back, onExpectationTimeout() reads the real state if the latest command is never confirmed
+        qCDebug(m_logCategory) << "Optimistic state" << itemId << "still pending, dropped" << state.toString();
+        return;
+    }
+    _expectations.erase(expectation);
+}
+
+bool OpenHAB::sameState(const OpenHABState& a, const OpenHABState& b) {
+    if (a.type != b.type) {
+        return false;
+    }
+    switch (a.type) {
+        case OpenHABState::ON_OFF:
+        case OpenHABState::UP_DOWN:
+            return a.on == b.on;
+        case OpenHABState::PERCENT:
+        case OpenHABState::DECIMAL:
+            return qAbs(a.number - b.number) < 0.5;
+        case OpenHABState::HSB:
+            return qAbs(a.hue - b.hue) < 0.5 && qAbs(a.saturation - b.saturation) < 0.5 &&
+                   qAbs(a.brightness - b.brightness) < 0.5;
+        case OpenHABState::STRING:
+            return a.toString() == b.toString();
+        default:
+            return true;
+    }
+}
+
+void OpenHAB::onExpectationTimeout() {
+    qint64 now = _clock.elapsed();
+    qint64 next = -1;
+
+    for (auto i = _expectations.begin(); i != _expectations.end();) {
+        if (i->deadline <= now) {
+            // no echo from openHAB in time, fetch the real state
+            qCDebug(m_logCategory) << "Optimistic state" << i.key() << "timed out, refreshing item";
+            getItem(i.key());
+            i = _expectations.erase(i);
+        } else {
+            next = next < 0 ? i->deadline : qMin(next, i->deadline);
+            ++i;
+        }
+    }
+    if (next >= 0) {
+        _expectationTimer->start(static_cast<int>(next - now));
+    }
+}
+
+void OpenHAB::sendOpenHABCommand(const QString& itemId, const QString& state) {
+    auto binding = _entityIndex.constFind(itemId);
+    _tracer.begin(itemId, binding != _entityIndex.constEnd() ? binding->entity->type() : QString(), _clock.elapsed());
+    _commandQueue->enqueue(itemId, state);
+}
 
-    _nam->post(request, state.toUtf8());
+QNetworkReply* OpenHAB::postCommand(const QString& itemId, const QString& state) {
+    QNetworkReply* reply = _nam->post(_requests.command(itemId), state.toUtf8());
+    _metrics.add(OpenHABMetrics::COMMANDS);
+    _tracer.posted(itemId, _clock.elapsed());
+    QObject::connect(reply, &QNetworkReply::finished, context_openHab,
+                     [this, reply, itemId]() { onCommandReply(reply, itemId); });
+    return reply;
 }
 
 void OpenHAB::getSystemInfo() {
-    QNetworkRequest request(_url + "/systeminfo");
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "text/plain");
-    if (_token != "") {
-        request.setRawHeader("accept", "*/*");
-        QString token = "Bearer " + _token;
-        request.setRawHeader("Authorization", token.toUtf8());
-    }
-    _nam->get(request);
+    QNetworkReply* reply = _nam->get(_requests.json("systeminfo"));
+    QObject::connect(reply, &QNetworkReply::finished, context_openHab, [this, reply]() { onSystemInfoReply(reply); });
 }
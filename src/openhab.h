@@ -25,16 +25,31 @@
 #pragma once
 
 #include <QColor>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QList>
+#include <QMap>
 #include <QNetworkAccessManager>
 #include <QNetworkConfigurationManager>
 #include <QNetworkInterface>
 #include <QNetworkReply>
+#include <QSet>
 #include <QString>
 #include <QTimer>
 
+#include "openhab_commandqueue.h"
+#include "openhab_commandtracer.h"
+#include "openhab_entityupdater.h"
+#include "openhab_eventdecoder.h"
+#include "openhab_itemsreader.h"
+#include "openhab_metrics.h"
+#include "openhab_reconnectscheduler.h"
+#include "openhab_requestfactory.h"
+#include "openhab_sseparser.h"
+#include "openhab_stateparser.h"
 #include "yio-interface/entities/lightinterface.h"
 #include "yio-interface/entities/mediaplayerinterface.h"
 #include "yio-interface/notificationsinterface.h"
@@ -42,7 +57,35 @@
 #include "yio-plugin/integration.h"
 #include "yio-plugin/plugin.h"
 
-const bool NO_WORKER_THREAD = false;
+const bool USE_WORKER_THREAD = true;
+
+// maximum length of the topics query parameter for the SSE connection
+const int MAX_TOPIC_FILTER_LENGTH = 4096;
+
+// default minimum interval in ms between two commands for the same item
+const int DEFAULT_COMMAND_INTERVAL = 100;
+
+// default time in ms to wait for openHAB to confirm an optimistic state
+const int DEFAULT_OPTIMISTIC_TIMEOUT = 2000;
+
+// minimum interval in ms between two batches of entity updates, one frame of the UI
+const int ENTITY_UPDATE_INTERVAL = 16;
+
+// default maximum age in seconds of the state snapshot which is shown until openHAB answers
+const int DEFAULT_SNAPSHOT_MAX_AGE = 86400;
+
+// default time in s without data on the SSE connection before it is checked, and before a stream without heartbeat
+// events is renewed although openHAB is reachable
+const int DEFAULT_SSE_IDLE_TIMEOUT = 30;
+const int DEFAULT_SSE_MAX_IDLE = 300;
+
+// reconnection backoff in ms and number of failed attempts before the user is notified
+const int RECONNECT_INITIAL_DELAY = 1000;
+const int RECONNECT_MAX_DELAY = 60000;
+const int RECONNECT_NOTIFY_ATTEMPTS = 3;
+
+// maximum number of items refreshed with single item requests, more items are refreshed with one request
+const int MAX_PARALLEL_ITEM_REQUESTS = 20;
 
 class OpenHABPlugin : public Plugin {
     Q_OBJECT
@@ -68,6 +111,12 @@ class OpenHAB : public Integration {
 
     void sendCommand(const QString& type, const QString& entityId, int command, const QVariant& param) override;
 
+    /**
+     * @brief Returns the counters, latency histograms and command latencies per entity type of the integration,
+     *        including the counters of the command queue and the entity updater. Can be called from any thread.
+     */
+    Q_INVOKABLE QVariantMap metrics();
+
  private slots:
     void connect() override;
     void disconnect() override;
@@ -75,51 +124,159 @@ class OpenHAB : public Integration {
     void enterStandby() override;
 
     void streamFinished(QNetworkReply* reply);
-    void networkManagerFinished(QNetworkReply* reply);
     void streamReceived();
     void onSseTimeout();
+    void onProbeTimeout();
     void onNetWorkAccessible(QNetworkAccessManager::NetworkAccessibility accessibility);
+    void onExpectationTimeout();
+    void onWatchdogTimeout();
+
+ private:
+    enum EntityFeature {
+        FEATURE_BRIGHTNESS = 0x01,
+        FEATURE_COLOR = 0x02,
+        FEATURE_COLORTEMP = 0x04,
+        FEATURE_POSITION = 0x08
+    };
+
+    struct ItemBinding;
+    typedef void (OpenHAB::*StateHandler)(const OpenHABState& state, const ItemBinding& binding);
+
+    // Entity, supported features and state handler resolved once at connect time for an openHAB item
+    struct ItemBinding {
+        EntityInterface* entity = nullptr;
+        int              features = 0;
+        StateHandler     handler = nullptr;
+        int              attribute = -1;  // YIO attribute of a thing channel item, -1 for the entity item
+        QByteArray       lastValue;       // raw state last received, repeated states are dropped before parsing
+        QByteArray       itemType;        // openHAB item type, e.g. "Dimmer", decides if numbers are percentages
+    };
+
+    // Items linked to the channels of an openHAB thing which is bound to one YIO entity
+    struct ThingBinding {
+        QHash<QString, QString> channels;    // channel id -> openHAB item
+        QHash<int, QString>     attributes;  // YIO attribute -> openHAB item
+        QHash<QString, int>     items;       // openHAB item -> YIO attribute
+    };
+
+    // Optimistically applied state waiting for the confirmation by openHAB
+    struct Expectation {
+        QString state;
+        qint64  deadline = 0;  // in ms of _clock
+    };
 
  private:
-    void startSse();
-    void getItems();
-    void getSystemInfo();
-    void jsonError(const QString& error);
-    void processItem(const QJsonDocument& result);
-    void processItems(const QJsonDocument& result, bool first);
-    void processEntity(const QJsonObject& item, EntityInterface* entity);
-    void processPlayerItem(const QString& item, const QString& name);
-    void processLight(const QString& value, EntityInterface* entity, bool isDimmer);
-    void processBlind(const QString& value, EntityInterface* entity);
-    void processSwitch(const QString& value, EntityInterface* entity);
-    void processComplexLight(const QString& value, EntityInterface* entity);
+    void           startSse();
+    void           stopSse();
+    void           abortRequests();
+    void           streamOpened(QNetworkReply* reply);
+    void           onWatchdogReply(QNetworkReply* reply);
+    QStringList    boundItems() const;
+    void           onSystemInfoReply(QNetworkReply* reply);
+    void           onItemReply(QNetworkReply* reply);
+    void           onCommandReply(QNetworkReply* reply, const QString& itemId);
+    void           onProbeSucceeded();
+    void           onProbeFailed(int httpStatus);
+    void           notifyConnectionProblem();
+    void           getItems();
+    QNetworkReply* getItemStates();
+    void           getThings();
+    void           onThingsReply(QNetworkReply* reply);
+    template <typename Attribute>
+    static bool matchThing(const QJsonObject& thing, const QMap<QString, Attribute>& channels,
+                           const QList<Attribute>& mandatory, int channelcount, ThingBinding* binding);
+    void           bindThing(EntityInterface* entity, const ThingBinding& thing, StateHandler handler);
+    QNetworkReply* requestItems(const QString& query, bool bootstrap);
+    void           itemsReceived(QNetworkReply* reply);
+    void           itemsFinished(QNetworkReply* reply);
+    void           onItemRead(const OpenHABItemsReader::Item& item);
+    void           resyncItems(const QStringList& items);
+    void           resyncFinished();
+    void           checkResyncValue(const ItemBinding& binding, const QByteArray& value);
+    void           getSystemInfo();
+    void           jsonError(const QString& error);
+    void           collectMetrics();
+    void           processEvent(const QByteArray& data);
+    QString        snapshotPath() const;
+    void           saveSnapshot();
+    void           loadSnapshot();
+    void           buildEntityIndex();
+    void           updateEventFilter();
+    ItemBinding    bindEntity(EntityInterface* entity);
+    static int     entityFeatures(EntityInterface* entity);
+    void           processItem(const QJsonDocument& result);
+    void           processState(const ItemBinding& binding, const OpenHABState& state);
+    void           handleLightState(const OpenHABState& state, const ItemBinding& binding);
+    void           handleBlindState(const OpenHABState& state, const ItemBinding& binding);
+    void           handleSwitchState(const OpenHABState& state, const ItemBinding& binding);
+    void           handleMediaPlayerState(const OpenHABState& state, const ItemBinding& binding);
+    void processPlayerItem(const OpenHABState& state, EntityInterface* entity, MediaPlayerDef::Attributes attr);
+    void processLight(const OpenHABState& state, const ItemBinding& binding, bool isDimmer);
+    void processBlind(const OpenHABState& state, const ItemBinding& binding);
+    void processSwitch(const OpenHABState& state, EntityInterface* entity);
+    void handleComplexLightState(const OpenHABState& state, const ItemBinding& binding);
+    void processComplexLight(const OpenHABState& state, const ItemBinding& binding, LightDef::Attributes attr);
     void sendOpenHABCommand(const QString& itemId, const QString& state);
-    void getItem(const QString name);
+    QNetworkReply* postCommand(const QString& itemId, const QString& state);
+    void           applyOptimisticState(const QString& itemId, const QString& state);
+    void           reconcileState(const QString& itemId, const OpenHABState& state);
+    static bool    sameState(const OpenHABState& a, const OpenHABState& b);
+    QNetworkReply* getItem(const QString name);
 
+    const QString* lookupThingItem(const QString& entityId, int attr);
+    const QString* lookupThingChannel(const QString& entityId, const QString& channel);
     const QString* lookupPlayerItem(const QString& entityId, MediaPlayerDef::Attributes attr);
     const QString* lookupComplexLightItem(const QString& entityId, LightDef::Attributes attr);
 
  private:
-    QNetworkInterface       _iface;
-    QNetworkAccessManager*  _sseNetworkManager;
-    QNetworkReply*          _sseReply;
-    QTimer*                 _sseReconnectTimer;
-    QString                 _url;
-    QString                 _token;
-    int                     _networktries = 0;
-    QNetworkAccessManager*  _nam;
-    bool                    _flagleaveStandby = false;
-    QList<EntityInterface*> _myEntities;  // Entities of this integration
-    QRegExp                 _colorValueTemplate =
-        QRegExp("[0-9]?[0-9]?[0-9][,][0-9]?[0-9]?[0-9][,][0-9]?[0-9][.]?[0-9]?[0-9]?[0-9]?[0-9]?");
-    QRegExp _brightnessValueTemplate = QRegExp("[1]?[0-9]?[0-9]");
-    int     _tries;
-    bool    _flagStandby;
+    QNetworkInterface                _iface;
+    QNetworkReply*                   _sseReply;
+    OpenHABReconnectScheduler*       _sseScheduler;
+    OpenHABReconnectScheduler*       _probeScheduler;
+    QTimer*                          _watchdogTimer;
+    QNetworkReply*                   _watchdogProbe = nullptr;
+    int                              _sseIdleTimeout = DEFAULT_SSE_IDLE_TIMEOUT;
+    int                              _sseMaxIdle = DEFAULT_SSE_MAX_IDLE;
+    qint64                           _sseLastData = 0;       // in ms of _clock
+    bool                             _sseHeartbeat = false;  // openHAB sends alive events on the current stream
+    qint64                           _sseOutageStart = -1;   // in ms of _clock, -1 if no events were missed
+    QSet<QNetworkReply*>             _resyncReplies;         // pending requests of the current resync
+    QSet<EntityInterface*>           _resyncCorrected;       // entities which had a different state
+    int                              _resyncItems = 0;
+    bool                             _connectionNotified = false;
+    QString                          _url;
+    QString                          _token;
+    QNetworkAccessManager*           _nam;  // shared by all requests, keeps the connections to openHAB open
+    OpenHABRequestFactory            _requests;
+    OpenHABCommandQueue*             _commandQueue;
+    OpenHABEntityUpdater*            _updater;  // entity changes for the main thread
+    bool                             _optimistic = false;
+    int                              _optimisticTimeout = DEFAULT_OPTIMISTIC_TIMEOUT;
+    QHash<QString, Expectation>      _expectations;  // openHAB item name -> optimistic state
+    QTimer*                          _expectationTimer;
+    QElapsedTimer                    _clock;
+    QList<EntityInterface*>          _myEntities;     // Entities of this integration
+    QHash<QString, ItemBinding>      _entityIndex;    // openHAB item name -> entity of this integration
+    QHash<QString, EntityInterface*> _thingEntities;  // openHAB thing UID -> entity bound to the channels of the thing
+    QHash<QString, ThingBinding>     _thingBindings;  // entity id -> items of the bound openHAB thing
+    QSet<QByteArray>                 _itemFilter;     // openHAB item names of this integration for the SSE event filter
+    QString                          _sseTopics;      // server side SSE topic filter, empty if all events are received
+    bool                             _stateChangedEvents = false;  // ItemStateChangedEvent instead of ItemStateEvent
+    int                              _snapshotMaxAge = DEFAULT_SNAPSHOT_MAX_AGE;
+    bool                             _snapshotLoaded = false;
+    OpenHABMetrics                   _metrics;
+    OpenHABCommandTracer             _tracer;
+    bool                             _flagStandby;
     // bool     _flagprocessitems = false;
     bool _flagOpenHabConnected = false;
     // QObject* context = new QObject(this);
-    QString        _tempJSONData = "";
-    OpenHAB*       context_openHab;
-    bool           _flagSseConnected = false;
-    bool           _flagMoreDataNeeded = false;
+    OpenHAB*               context_openHab;
+    bool                   _flagSseConnected = false;
+    OpenHABSseParser       _sseParser;
+    OpenHABEventDecoder    _eventDecoder;
+    OpenHABItemsReader     _itemsReader;
+    QNetworkReply*         _itemsReply = nullptr;  // items list which is currently read
+    bool                   _itemsBootstrap = false;
+    QSet<EntityInterface*> _itemsSeen;  // entities with items in the current items list
+    QElapsedTimer          _itemsTimer;
 };
@@ -0,0 +1,85 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_commandqueue.h"
+
+#include <QTimer>
+
+OpenHABCommandQueue::OpenHABCommandQueue(Sender sender, QObject* parent) : QObject(parent), _sender(sender) {}
+
+void OpenHABCommandQueue::enqueue(const QString& itemId, const QString& state) {
+    ItemQueue& queue = _queues[itemId];
+    if (queue.pending) {
+        _coalesced++;
+    }
+    queue.state = state;
+    queue.pending = true;
+    trySend(itemId);
+}
+
+void OpenHABCommandQueue::clear() {
+    for (const ItemQueue& queue : qAsConst(_queues)) {
+        if (queue.pending) {
+            _dropped++;
+        }
+    }
+    _queues.clear();
+}
+
+void OpenHABCommandQueue::trySend(const QString& itemId) {
+    auto queue = _queues.find(itemId);
+    if (queue == _queues.end() || !queue->pending || queue->scheduled || queue->reply != nullptr) {
+        return;
+    }
+
+    qint64 wait = queue->lastSent.isValid() ? _minInterval - queue->lastSent.elapsed() : 0;
+    if (wait > 0) {
+        queue->scheduled = true;
+        QTimer::singleShot(static_cast<int>(wait), this, [this, itemId]() {
+            auto queue = _queues.find(itemId);
+            if (queue != _queues.end()) {
+                queue->scheduled = false;
+                trySend(itemId);
+            }
+        });
+        return;
+    }
+
+    queue->pending = false;
+    queue->lastSent.start();
+    QNetworkReply* reply = _sender(itemId, queue->state);
+    if (reply == nullptr) {
+        _dropped++;
+        return;
+    }
+    _sent++;
+    // the sender doesn't modify the queues, so the iterator is still valid
+    queue->reply = reply;
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, itemId, reply]() {
+        reply->deleteLater();
+        auto queue = _queues.find(itemId);
+        if (queue != _queues.end() && queue->reply == reply) {
+            queue->reply = nullptr;
+            trySend(itemId);
+        }
+    });
+}
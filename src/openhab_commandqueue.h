@@ -0,0 +1,79 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QNetworkReply>
+#include <QObject>
+#include <QString>
+#include <functional>
+
+/**
+ * @brief Outbound command queue with at most one request in flight per item.
+ *
+ * While a command for an item is in flight or the minimum interval since the last command has not yet elapsed, a new
+ * command replaces the queued one (latest wins). Dragging a slider therefore only sends the values openHAB can keep
+ * up with, ending with the final one.
+ */
+class OpenHABCommandQueue : public QObject {
+    Q_OBJECT
+
+ public:
+    // Sends the command and returns the pending reply or nullptr if the command couldn't be sent
+    typedef std::function<QNetworkReply*(const QString& itemId, const QString& state)> Sender;
+
+    explicit OpenHABCommandQueue(Sender sender, QObject* parent = nullptr);
+
+    void setMinInterval(int ms) { _minInterval = ms; }
+    int  minInterval() const { return _minInterval; }
+
+    void enqueue(const QString& itemId, const QString& state);
+
+    /**
+     * @brief Discards all queued commands, e.g. on disconnect. Discarded commands are counted as dropped.
+     */
+    void clear();
+
+    int sent() const { return _sent; }
+    int coalesced() const { return _coalesced; }
+    int dropped() const { return _dropped; }
+
+ private:
+    struct ItemQueue {
+        QString        state;  // queued state, valid if pending is set
+        bool           pending = false;
+        bool           scheduled = false;
+        QNetworkReply* reply = nullptr;  // command in flight
+        QElapsedTimer  lastSent;
+    };
+
+    void trySend(const QString& itemId);
+
+    Sender                    _sender;
+    int                       _minInterval = 0;
+    QHash<QString, ItemQueue> _queues;
+    int                       _sent = 0;
+    int                       _coalesced = 0;
+    int                       _dropped = 0;
+};
@@ -0,0 +1,160 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_commandtracer.h"
+
+#include <QVariantList>
+#include <algorithm>
+
+static QVariantMap percentiles(QVector<qint64> values) {
+    QVariantMap map;
+    if (values.isEmpty()) {
+        return map;
+    }
+    std::sort(values.begin(), values.end());
+    // nearest rank
+    auto rank = [&values](int percent) { return values[qMax(0, (values.size() * percent + 99) / 100 - 1)]; };
+    map.insert("count", values.size());
+    map.insert("p50", rank(50));
+    map.insert("p90", rank(90));
+    map.insert("p99", rank(99));
+    map.insert("max", values.last());
+    return map;
+}
+
+OpenHABCommandTracer::OpenHABCommandTracer(int capacity) : _ring(capacity) {}
+
+void OpenHABCommandTracer::begin(const QString& item, const QString& type, qint64 now) {
+    auto open = _open.find(item);
+    if (open != _open.end() && open->posted >= 0) {
+        // superseded by the new command before openHAB echoed the state
+        close(*open);
+    }
+    // a command which wasn't posted yet is replaced in the command queue as well
+    Trace& trace = _open[item];
+    trace = Trace();
+    trace.item = item;
+    trace.type = type;
+    trace.queued = now;
+}
+
+void OpenHABCommandTracer::posted(const QString& item, qint64 now) {
+    auto open = _open.find(item);
+    if (open != _open.end() && open->posted < 0) {
+        open->posted = now;
+    }
+}
+
+void OpenHABCommandTracer::replied(const QString& item, int status, qint64 now) {
+    auto open = _open.find(item);
+    // answers and events before the POST belong to an older command of the item
+    if (open == _open.end() || open->posted < 0 || open->replied >= 0) {
+        return;
+    }
+    open->replied = now;
+    open->status = status;
+    if (open->echoed >= 0) {
+        close(*open);
+        _open.erase(open);
+    }
+}
+
+qint64 OpenHABCommandTracer::echoed(const QString& item, qint64 now) {
+    auto open = _open.find(item);
+    if (open == _open.end() || open->posted < 0 || open->echoed >= 0) {
+        return -1;
+    }
+    qint64 posted = open->posted;
+    open->echoed = now;
+    if (open->replied >= 0) {
+        close(*open);
+        _open.erase(open);
+    }
+    return posted;
+}
+
+void OpenHABCommandTracer::closeAll() {
+    for (const Trace& trace : qAsConst(_open)) {
+        close(trace);
+    }
+    _open.clear();
+}
+
+void OpenHABCommandTracer::close(const Trace& trace) {
+    _ring[_next] = trace;
+    _next = (_next + 1) % _ring.size();
+    _count = qMin(_count + 1, _ring.size());
+}
+
+QVector<OpenHABCommandTracer::Trace> OpenHABCommandTracer::traces() const {
+    QVector<Trace> traces;
+    traces.reserve(_count);
+    for (int i = 0; i < _count; ++i) {
+        traces.append(_ring[(_next + _ring.size() - _count + i) % _ring.size()]);
+    }
+    return traces;
+}
+
+QVariantMap OpenHABCommandTracer::summary() const {
+    struct Phases {
+        QVector<qint64> queue;
+        QVector<qint64> post;
+        QVector<qint64> echo;
+        int             failed = 0;      // answered with an error
+        int             unanswered = 0;  // replaced by a newer command or closed before the answer
+        int             unechoed = 0;
+    };
+    QHash<QString, Phases> types;
+
+    for (const Trace& trace : traces()) {
+        Phases& phases = types[trace.type];
+        if (trace.posted >= 0) {
+            phases.queue.append(trace.posted - trace.queued);
+        }
+        if (trace.posted >= 0 && trace.replied >= 0) {
+            phases.post.append(trace.replied - trace.posted);
+        }
+        if (trace.replied < 0) {
+            phases.unanswered++;
+        } else if (trace.status == 0 || trace.status >= 300) {
+            phases.failed++;
+        }
+        if (trace.echoed >= 0) {
+            phases.echo.append(trace.echoed - trace.queued);
+        } else {
+            phases.unechoed++;
+        }
+    }
+
+    QVariantMap map;
+    for (auto i = types.constBegin(); i != types.constEnd(); ++i) {
+        QVariantMap type;
+        type.insert("queue", percentiles(i->queue));
+        type.insert("post", percentiles(i->post));
+        type.insert("echo", percentiles(i->echo));
+        type.insert("failed", i->failed);
+        type.insert("unanswered", i->unanswered);
+        type.insert("unechoed", i->unechoed);
+        map.insert(i.key(), type);
+    }
+    return map;
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVariantMap>
+#include <QVector>
+
+/**
+ * @brief Traces commands from sendCommand to the state event of the item.
+ *
+ * A trace records when the command was queued, when the POST was started and answered, the HTTP status and when the
+ * next state event of the item arrived. Closed traces are kept in a ring buffer, the summary gives the percentiles of
+ * each phase per entity type. Times are in ms of a monotonic clock of the caller.
+ */
+class OpenHABCommandTracer {
+ public:
+    struct Trace {
+        QString item;
+        QString type;  // entity type, e.g. "light"
+        qint64  queued = -1;
+        qint64  posted = -1;
+        qint64  replied = -1;
+        qint64  echoed = -1;  // -1 if no state event arrived
+        int     status = 0;   // HTTP status of the POST, 0 if not answered
+    };
+
+    explicit OpenHABCommandTracer(int capacity = 128);
+
+    void begin(const QString& item, const QString& type, qint64 now);
+    void posted(const QString& item, qint64 now);
+    void replied(const QString& item, int status, qint64 now);
+
+    /**
+     * @brief Records the state event of the item. Returns the time of the POST or -1 if no command of the item waits
+     *        for its echo. The event can arrive before the POST is answered, the trace is closed when both are there.
+     */
+    qint64 echoed(const QString& item, qint64 now);
+
+    bool hasOpenTraces() const { return !_open.isEmpty(); }
+
+    /**
+     * @brief Closes all open traces without an echo, e.g. on disconnect
+     */
+    void closeAll();
+
+    /**
+     * @brief Percentiles per entity type of queue (queued to posted), post (posted to replied) and echo (queued to
+     *        state event) times
+     */
+    QVariantMap summary() const;
+
+    /**
+     * @brief The closed traces, oldest first
+     */
+    QVector<Trace> traces() const;
+
+ private:
+    void close(const Trace& trace);
+
+    QHash<QString, Trace> _open;  // openHAB item name -> trace of the last command
+    QVector<Trace>        _ring;
+    int                   _next = 0;
+    int                   _count = 0;
+};
@@ -0,0 +1,116 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_entityupdater.h"
+
+#include <QCoreApplication>
+#include <QMetaObject>
+
+OpenHABEntityUpdater::OpenHABEntityUpdater(QObject* parent) : QObject(parent) {
+    _timer = new QTimer(this);
+    _timer->setSingleShot(true);
+    connect(_timer, &QTimer::timeout, this, &OpenHABEntityUpdater::flush);
+}
+
+void OpenHABEntityUpdater::setState(EntityInterface* entity, int state) { enqueue(entity, STATE_UPDATE, state); }
+
+void OpenHABEntityUpdater::updateAttribute(EntityInterface* entity, int attribute, const QVariant& value) {
+    enqueue(entity, attribute, value);
+}
+
+void OpenHABEntityUpdater::setConnected(EntityInterface* entity, bool connected) {
+    if (connected) {
+        _connected.insert(entity);
+    } else {
+        _connected.remove(entity);
+    }
+    enqueue(entity, CONNECTED_UPDATE, connected);
+}
+
+void OpenHABEntityUpdater::reset() { _values.clear(); }
+
+void OpenHABEntityUpdater::enqueue(EntityInterface* entity, int attribute, const QVariant& value) {
+    Key  key(entity, attribute);
+    auto pending = _pending.constFind(key);
+
+    if (pending != _pending.constEnd()) {
+        // latest value wins, an unchanged result is dropped when flushing
+        _updates[*pending].value = value;
+        _coalesced++;
+        return;
+    }
+    auto sent = _values.constFind(key);
+    if (sent != _values.constEnd() && *sent == value) {
+        _suppressed++;
+        return;
+    }
+    _pending.insert(key, _updates.size());
+    _updates.append({entity, attribute, value});
+
+    if (!_timer->isActive()) {
+        // a zero timeout runs after the network data which is currently processed
+        qint64 wait = _lastFlush.isValid() ? _minInterval - _lastFlush.elapsed() : 0;
+        _timer->start(wait > 0 ? static_cast<int>(wait) : 0);
+    }
+}
+
+void OpenHABEntityUpdater::flush() {
+    _timer->stop();
+    _lastFlush.start();
+
+    QVector<Update> updates;
+    updates.reserve(_updates.size());
+    for (const Update& update : qAsConst(_updates)) {
+        QVariant& sent = _values[Key(update.entity, update.attribute)];
+        if (sent.isValid() && sent == update.value) {
+            // changed back within the batch
+            _suppressed++;
+            continue;
+        }
+        sent = update.value;
+        updates.append(update);
+    }
+    _updates.clear();
+    _pending.clear();
+    if (updates.isEmpty()) {
+        return;
+    }
+    _applied += updates.size();
+    QMetaObject::invokeMethod(
+        QCoreApplication::instance(), [updates]() { apply(updates); }, Qt::QueuedConnection);
+}
+
+void OpenHABEntityUpdater::apply(const QVector<Update>& updates) {
+    for (const Update& update : updates) {
+        switch (update.attribute) {
+            case STATE_UPDATE:
+                update.entity->setState(update.value.toInt());
+                break;
+            case CONNECTED_UPDATE:
+                update.entity->setConnected(update.value.toBool());
+                break;
+            default:
+                update.entity->updateAttrByIndex(update.attribute, update.value);
+                break;
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QPair>
+#include <QSet>
+#include <QTimer>
+#include <QVariant>
+#include <QVector>
+
+#include "yio-interface/entities/entityinterface.h"
+
+/**
+ * @brief Hands the decoded state changes from the integration thread to the entities on the main thread.
+ *
+ * The entities drive the QML UI and must only be changed on the main thread. Updates are collected per entity and
+ * attribute, only the last value is kept and values the entity already has are dropped. The batch is applied with one
+ * queued call when the integration thread returns to its event loop, but not more often than the minimum interval, so
+ * a burst of events re-renders the UI once per frame.
+ * The connected flags are mirrored, so the integration thread doesn't have to wait for the main thread to read them.
+ */
+class OpenHABEntityUpdater : public QObject {
+    Q_OBJECT
+
+ public:
+    explicit OpenHABEntityUpdater(QObject* parent = nullptr);
+
+    void setMinInterval(int ms) { _minInterval = ms; }
+    int  minInterval() const { return _minInterval; }
+
+    void setState(EntityInterface* entity, int state);
+    void updateAttribute(EntityInterface* entity, int attribute, const QVariant& value);
+    void setConnected(EntityInterface* entity, bool connected);
+    bool isConnected(EntityInterface* entity) const { return _connected.contains(entity); }
+
+    /**
+     * @brief Forgets the values sent to the entities, e.g. when all items are read again
+     */
+    void reset();
+
+    /**
+     * @brief Sends the collected updates to the main thread, called by the timer
+     */
+    void flush();
+
+    int applied() const { return _applied; }
+    int coalesced() const { return _coalesced; }
+    int suppressed() const { return _suppressed; }
+
+ private:
+    enum { STATE_UPDATE = -1, CONNECTED_UPDATE = -2 };
+
+    typedef QPair<EntityInterface*, int> Key;  // entity and attribute, STATE_UPDATE or CONNECTED_UPDATE
+
+    struct Update {
+        EntityInterface* entity;
+        int              attribute;
+        QVariant         value;
+    };
+
+    void        enqueue(EntityInterface* entity, int attribute, const QVariant& value);
+    static void apply(const QVector<Update>& updates);
+
+    QVector<Update>        _updates;  // in the order of the first change
+    QHash<Key, int>        _pending;  // index of the update in _updates
+    QHash<Key, QVariant>   _values;   // last value sent to the main thread
+    QSet<EntityInterface*> _connected;
+    QTimer*                _timer;
+    QElapsedTimer          _lastFlush;
+    int                    _minInterval = 0;
+    int                    _applied = 0;
+    int                    _coalesced = 0;
+    int                    _suppressed = 0;
+};
@@ -0,0 +1,135 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_eventdecoder.h"
+
+#include "openhab_jsonscanner.h"
+
+using OpenHABJson::Token;
+using OpenHABJson::scanObject;
+using OpenHABJson::scanString;
+using OpenHABJson::skipWhitespace;
+using OpenHABJson::tokenEquals;
+using OpenHABJson::unescape;
+using OpenHABJson::view;
+
+bool OpenHABEventDecoder::decode(const QByteArray& data, Event* event) {
+    Token topic;
+    Token payload;
+    Token type;
+
+    *event = Event();
+    const char* begin = data.constData();
+    bool        valid = scanObject(begin, begin + data.size(), [&](const Token& key, const Token& value) {
+        if (tokenEquals(key, "topic")) {
+            topic = value;
+        } else if (tokenEquals(key, "payload")) {
+            payload = value;
+        } else if (tokenEquals(key, "type")) {
+            type = value;
+        }
+    });
+    if (!valid || type.data == nullptr) {
+        return false;
+    }
+
+    if (tokenEquals(type, "ItemStateEvent")) {
+        event->type = ITEM_STATE;
+    } else if (tokenEquals(type, "ItemStateChangedEvent")) {
+        event->type = ITEM_STATE_CHANGED;
+    } else if (tokenEquals(type, "GroupItemStateChangedEvent")) {
+        event->type = GROUP_ITEM_STATE_CHANGED;
+    } else {
+        return true;
+    }
+
+    if (topic.escaped) {
+        unescape(topic, &_topic);
+        event->item = itemFromTopic(_topic);
+    } else {
+        event->item = itemFromTopic(view(topic.data, topic.size));
+    }
+
+    if (payload.data == nullptr) {
+        return false;
+    }
+    unescape(payload, &_payload);
+
+    Token valueType;
+    Token value;
+    valid = scanObject(_payload.constData(), _payload.constData() + _payload.size(),
+                       [&](const Token& key, const Token& member) {
+                           if (tokenEquals(key, "type")) {
+                               valueType = member;
+                           } else if (tokenEquals(key, "value")) {
+                               value = member;
+                           }
+                       });
+    if (!valid || value.data == nullptr) {
+        return false;
+    }
+    event->valueType = view(valueType.data, valueType.size);
+    if (value.escaped) {
+        unescape(value, &_value);
+        event->value = view(_value.constData(), _value.size());
+    } else {
+        event->value = view(value.data, value.size);
+    }
+    return true;
+}
+
+QByteArray OpenHABEventDecoder::peekItem(const QByteArray& data) {
+    // openHAB serializes the topic as first member, so this is usually a short scan at the start of the message
+    const int index = data.indexOf("\"topic\"");
+    if (index < 0) {
+        return QByteArray();
+    }
+    const char* end = data.constData() + data.size();
+    const char* p = skipWhitespace(data.constData() + index + 7, end);
+    if (p == end || *p != ':') {
+        return QByteArray();
+    }
+    p = skipWhitespace(p + 1, end);
+    if (p == end || *p != '"') {
+        return QByteArray();
+    }
+    Token topic;
+    if (scanString(p, end, &topic) == nullptr || topic.escaped) {
+        return QByteArray();
+    }
+    return itemFromTopic(view(topic.data, topic.size));
+}
+
+QByteArray OpenHABEventDecoder::itemFromTopic(const QByteArray& topic) {
+    // <namespace>/items/<name>/<event>
+    int start = topic.indexOf('/');
+    start = start < 0 ? -1 : topic.indexOf('/', start + 1);
+    if (start < 0) {
+        return QByteArray();
+    }
+    ++start;
+    int end = topic.indexOf('/', start);
+    if (end < 0) {
+        end = topic.size();
+    }
+    return view(topic.constData() + start, end - start);
+}
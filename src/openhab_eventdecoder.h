@@ -0,0 +1,71 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+
+/**
+ * @brief Lightweight decoder for the openHAB event bus messages received through SSE.
+ *
+ * Example of an event:
+ * {"topic":"smarthome/items/Light/state","payload":"{\"type\":\"OnOff\",\"value\":\"ON\"}","type":"ItemStateEvent"}
+ *
+ * The envelope is scanned once without building a JSON document. The payload, which is a JSON document encoded as
+ * string, is unescaped into a reused buffer and scanned the same way.
+ */
+class OpenHABEventDecoder {
+ public:
+    enum Type { UNKNOWN, ITEM_STATE, ITEM_STATE_CHANGED, GROUP_ITEM_STATE_CHANGED };
+
+    /**
+     * @brief Decoded event. All members are views into the received data or into buffers of the decoder, they are
+     *        only valid until the next call of decode(). Use a deep copy to keep a value.
+     */
+    struct Event {
+        Type       type = UNKNOWN;
+        QByteArray item;       // item name from the topic
+        QByteArray valueType;  // openHAB state type, e.g. "OnOff", "Percent" or "HSB"
+        QByteArray value;      // state value
+    };
+
+    /**
+     * @brief Decodes an event. Returns false if the data is not a valid event message.
+     */
+    bool decode(const QByteArray& data, Event* event);
+
+    /**
+     * @brief Reads only the topic of an event and returns the item name as view into data, without decoding the
+     *        rest of the message. Returns an empty array if the topic can't be read this way.
+     */
+    static QByteArray peekItem(const QByteArray& data);
+
+    /**
+     * @brief Extracts the item name from an event topic like smarthome/items/<name>/state
+     */
+    static QByteArray itemFromTopic(const QByteArray& topic);
+
+ private:
+    QByteArray _topic;
+    QByteArray _payload;
+    QByteArray _value;
+};
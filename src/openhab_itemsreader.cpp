@@ -0,0 +1,154 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_itemsreader.h"
+
+#include "openhab_jsonscanner.h"
+
+using OpenHABJson::Token;
+
+void OpenHABItemsReader::reset() {
+    _buffer.clear();
+    _pos = 0;
+    _elementStart = -1;
+    _depth = 0;
+    _inString = false;
+    _escape = false;
+    _complete = false;
+    _error = false;
+    _itemCount = 0;
+    _peakBufferSize = 0;
+}
+
+bool OpenHABItemsReader::feed(const QByteArray& chunk) {
+    if (_error) {
+        return false;
+    }
+    if (_complete) {
+        return true;
+    }
+    _buffer.append(chunk);
+    _peakBufferSize = qMax(_peakBufferSize, _buffer.size());
+
+    const char* data = _buffer.constData();
+    const int   size = _buffer.size();
+
+    for (; _pos < size && !_complete; ++_pos) {
+        const char c = data[_pos];
+        if (_inString) {
+            if (_escape) {
+                _escape = false;
+            } else if (c == '\\') {
+                _escape = true;
+            } else if (c == '"') {
+                _inString = false;
+            }
+            continue;
+        }
+        switch (c) {
+            case '"':
+                _inString = true;
+                break;
+            case '[':
+            case '{':
+                if (_depth == 0 && c != '[') {
+                    _error = true;
+                    return false;
+                }
+                if (_depth == 1) {
+                    _elementStart = _pos;
+                }
+                _depth++;
+                break;
+            case ']':
+            case '}':
+                _depth--;
+                if (_depth == 1 && c == '}') {
+                    if (!processElement(data + _elementStart, _pos - _elementStart + 1)) {
+                        _error = true;
+                        return false;
+                    }
+                    _elementStart = -1;
+                } else if (_depth == 0) {
+                    _complete = true;
+                } else if (_depth < 0) {
+                    _error = true;
+                    return false;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    // drop everything which was processed, keep the incomplete element
+    int keep = _elementStart >= 0 ? _elementStart : _pos;
+    if (keep > 0) {
+        _buffer.remove(0, keep);
+        _pos -= keep;
+        if (_elementStart >= 0) {
+            _elementStart = 0;
+        }
+    }
+    return true;
+}
+
+bool OpenHABItemsReader::processElement(const char* data, int size) {
+    Token name;
+    Token state;
+    Token type;
+
+    bool valid = OpenHABJson::scanObject(data, data + size, [&](const Token& key, const Token& value) {
+        if (OpenHABJson::tokenEquals(key, "name")) {
+            name = value;
+        } else if (OpenHABJson::tokenEquals(key, "state")) {
+            state = value;
+        } else if (OpenHABJson::tokenEquals(key, "type")) {
+            type = value;
+        }
+    });
+    if (!valid) {
+        return false;
+    }
+    if (name.data == nullptr) {
+        return true;
+    }
+
+    Item item;
+    const Token* tokens[] = {&name, &state, &type};
+    QByteArray*  buffers[] = {&_name, &_state, &_type};
+    QByteArray*  views[] = {&item.name, &item.state, &item.type};
+    for (int i = 0; i < 3; ++i) {
+        if (tokens[i]->escaped) {
+            OpenHABJson::unescape(*tokens[i], buffers[i]);
+            *views[i] = OpenHABJson::view(buffers[i]->constData(), buffers[i]->size());
+        } else {
+            *views[i] = OpenHABJson::view(tokens[i]->data, tokens[i]->size);
+        }
+    }
+
+    _itemCount++;
+    if (_callback) {
+        _callback(item);
+    }
+    return true;
+}
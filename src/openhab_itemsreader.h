@@ -0,0 +1,90 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <functional>
+
+/**
+ * @brief Streaming reader for the JSON array returned by /rest/items.
+ *
+ * Chunks are fed as they are received from the network. As soon as an array element is complete, its name, state and
+ * type are passed to the callback and the bytes are discarded, so only the current item is kept in memory.
+ */
+class OpenHABItemsReader {
+ public:
+    /**
+     * @brief Item of the array. The members are views into the reader buffers, only valid during the callback.
+     */
+    struct Item {
+        QByteArray name;
+        QByteArray state;
+        QByteArray type;
+    };
+
+    typedef std::function<void(const Item& item)> Callback;
+
+    explicit OpenHABItemsReader(Callback callback = nullptr) : _callback(callback) {}
+
+    void setCallback(Callback callback) { _callback = callback; }
+
+    /**
+     * @brief Prepares the reader for a new document.
+     */
+    void reset();
+
+    /**
+     * @brief Parses the next chunk of the document. Returns false on a syntax error.
+     */
+    bool feed(const QByteArray& chunk);
+
+    /**
+     * @brief True if the closing bracket of the array was read.
+     */
+    bool isComplete() const { return _complete; }
+
+    int itemCount() const { return _itemCount; }
+
+    /**
+     * @brief Largest amount of buffered data, i.e. the memory needed for the document.
+     */
+    int peakBufferSize() const { return _peakBufferSize; }
+
+ private:
+    bool processElement(const char* data, int size);
+
+    Callback   _callback;
+    QByteArray _buffer;
+    int        _pos = 0;
+    int        _elementStart = -1;
+    int        _depth = 0;
+    bool       _inString = false;
+    bool       _escape = false;
+    bool       _complete = false;
+    bool       _error = false;
+    int        _itemCount = 0;
+    int        _peakBufferSize = 0;
+    QByteArray _name;
+    QByteArray _state;
+    QByteArray _type;
+};
@@ -0,0 +1,197 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_jsonscanner.h"
+
+#include <cstring>
+
+namespace {
+
+int hexValue(const char* p, const char* end) {
+    if (end - p < 4) {
+        return -1;
+    }
+    int value = 0;
+    for (int i = 0; i < 4; ++i) {
+        const char c = p[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9') {
+            value |= c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            value |= c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            value |= c - 'A' + 10;
+        } else {
+            return -1;
+        }
+    }
+    return value;
+}
+
+}  // namespace
+
+namespace OpenHABJson {
+
+bool tokenEquals(const Token& token, const char* literal) {
+    const int length = static_cast<int>(strlen(literal));
+    return token.size == length && memcmp(token.data, literal, length) == 0;
+}
+
+const char* skipWhitespace(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+        ++p;
+    }
+    return p;
+}
+
+const char* scanString(const char* p, const char* end, Token* token) {
+    const char* start = ++p;
+    token->escaped = false;
+    while (p < end) {
+        if (*p == '"') {
+            token->data = start;
+            token->size = static_cast<int>(p - start);
+            return p + 1;
+        }
+        if (*p == '\\') {
+            token->escaped = true;
+            p += 2;
+        } else {
+            ++p;
+        }
+    }
+    return nullptr;
+}
+
+const char* scanValue(const char* p, const char* end, Token* token) {
+    if (*p == '"') {
+        return scanString(p, end, token);
+    }
+    const char* start = p;
+    if (*p != '{' && *p != '[') {
+        // number, true, false or null: ends at the next delimiter
+        while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\n' &&
+               *p != '\r') {
+            ++p;
+        }
+        if (p == start) {
+            return nullptr;
+        }
+    } else {
+        int depth = 0;
+        while (p < end) {
+            const char c = *p;
+            if (c == '"') {
+                Token skipped;
+                p = scanString(p, end, &skipped);
+                if (p == nullptr) {
+                    return nullptr;
+                }
+                continue;
+            }
+            ++p;
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if ((c == '}' || c == ']') && --depth == 0) {
+                break;
+            }
+        }
+        if (depth != 0) {
+            return nullptr;
+        }
+    }
+    token->data = start;
+    token->size = static_cast<int>(p - start);
+    token->escaped = false;
+    return p;
+}
+
+void unescape(const Token& token, QByteArray* out) {
+    out->resize(token.size);
+    char*       dst = out->data();
+    const char* p = token.data;
+    const char* end = p + token.size;
+
+    while (p < end) {
+        char c = *p++;
+        if (c != '\\' || p == end) {
+            *dst++ = c;
+            continue;
+        }
+        c = *p++;
+        switch (c) {
+            case 'b':
+                *dst++ = '\b';
+                break;
+            case 'f':
+                *dst++ = '\f';
+                break;
+            case 'n':
+                *dst++ = '\n';
+                break;
+            case 'r':
+                *dst++ = '\r';
+                break;
+            case 't':
+                *dst++ = '\t';
+                break;
+            case 'u': {
+                int codepoint = hexValue(p, end);
+                if (codepoint < 0) {
+                    *dst++ = '?';
+                    break;
+                }
+                p += 4;
+                if (codepoint >= 0xD800 && codepoint <= 0xDBFF && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                    int low = hexValue(p + 2, end);
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                        p += 6;
+                    }
+                }
+                if (codepoint < 0x80) {
+                    *dst++ = static_cast<char>(codepoint);
+                } else if (codepoint < 0x800) {
+                    *dst++ = static_cast<char>(0xC0 | (codepoint >> 6));
+                    *dst++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+                } else if (codepoint < 0x10000) {
+                    *dst++ = static_cast<char>(0xE0 | (codepoint >> 12));
+                    *dst++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                    *dst++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+                } else {
+                    *dst++ = static_cast<char>(0xF0 | (codepoint >> 18));
+                    *dst++ = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+                    *dst++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                    *dst++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+                }
+                break;
+            }
+            default:
+                // \" \\ and \/
+                *dst++ = c;
+                break;
+        }
+    }
+    out->resize(static_cast<int>(dst - out->constData()));
+}
+
+}  // namespace OpenHABJson
@@ -0,0 +1,102 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+
+/**
+ * @brief Minimal JSON scanner working directly on UTF-8 bytes.
+ *
+ * Used for the hot paths where only a few members of flat JSON objects are needed and building a QJsonDocument would
+ * be too expensive. Nested values are skipped, strings are returned as raw (possibly escaped) byte ranges.
+ */
+namespace OpenHABJson {
+
+struct Token {
+    const char* data = nullptr;
+    int         size = 0;
+    bool        escaped = false;
+};
+
+bool tokenEquals(const Token& token, const char* literal);
+
+const char* skipWhitespace(const char* p, const char* end);
+
+// p points to the opening quote. Returns the position after the closing quote or nullptr.
+const char* scanString(const char* p, const char* end, Token* token);
+
+// Skips a string, scalar, object or array value. Returns the position after the value or nullptr.
+const char* scanValue(const char* p, const char* end, Token* token);
+
+// Unescapes a JSON string into out. The result is never longer than the escaped string, so out is sized once.
+void unescape(const Token& token, QByteArray* out);
+
+inline QByteArray view(const char* data, int size) { return QByteArray::fromRawData(data, size); }
+
+// Calls callback(key, value) for every member of a JSON object without descending into nested values.
+template <typename Callback>
+bool scanObject(const char* p, const char* end, Callback callback) {
+    p = skipWhitespace(p, end);
+    if (p == end || *p != '{') {
+        return false;
+    }
+    p = skipWhitespace(p + 1, end);
+    if (p < end && *p == '}') {
+        return true;
+    }
+    while (p < end && *p == '"') {
+        Token key;
+        Token value;
+        p = scanString(p, end, &key);
+        if (p == nullptr) {
+            return false;
+        }
+        p = skipWhitespace(p, end);
+        if (p == end || *p != ':') {
+            return false;
+        }
+        p = skipWhitespace(p + 1, end);
+        if (p == end) {
+            return false;
+        }
+        p = scanValue(p, end, &value);
+        if (p == nullptr) {
+            return false;
+        }
+        callback(key, value);
+        p = skipWhitespace(p, end);
+        if (p == end) {
+            return false;
+        }
+        if (*p == '}') {
+            return true;
+        }
+        if (*p != ',') {
+            return false;
+        }
+        p = skipWhitespace(p + 1, end);
+    }
+    return false;
+}
+
+}  // namespace OpenHABJson
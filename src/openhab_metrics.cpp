@@ -0,0 +1,99 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_metrics.h"
+
+#include <QStringList>
+#include <QVariantList>
+
+// upper bounds in ms of the histogram buckets, the last bucket takes all longer durations
+const int OpenHABMetrics::BUCKET_BOUNDS[BUCKET_COUNT - 1] = {5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000};
+
+const char* OpenHABMetrics::COUNTER_NAMES[COUNTER_COUNT] = {
+    "sseBytes",         "sseEvents",          "ssePartialFrames",  "sseReconnects",   "resyncItems",
+    "resyncCorrected",  "eventsUnconfigured", "eventsRepeated",    "eventsProcessed", "jsonErrors",
+    "probeFailures",    "commands",           "commandsCoalesced", "commandsDropped", "updatesApplied",
+    "updatesCoalesced", "updatesSuppressed"};
+
+const char* OpenHABMetrics::HISTOGRAM_NAMES[HISTOGRAM_COUNT] = {"commandRoundTrip", "itemsRead", "sseOutage"};
+
+void OpenHABMetrics::record(Histogram histogram, qint64 ms) {
+    HistogramData& data = _histograms[histogram];
+    int            bucket = 0;
+
+    while (bucket < BUCKET_COUNT - 1 && ms > BUCKET_BOUNDS[bucket]) {
+        ++bucket;
+    }
+    data.buckets[bucket]++;
+    data.count++;
+    data.sum += ms;
+    data.max = qMax(data.max, ms);
+}
+
+QVariantMap OpenHABMetrics::toVariantMap() const {
+    QVariantMap  map;
+    QVariantList bounds;
+
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        map.insert(COUNTER_NAMES[i], _counters[i]);
+    }
+    for (int bound : BUCKET_BOUNDS) {
+        bounds.append(bound);
+    }
+    for (int i = 0; i < HISTOGRAM_COUNT; ++i) {
+        const HistogramData& data = _histograms[i];
+        QVariantMap          histogram;
+        QVariantList         buckets;
+        for (qint64 bucket : data.buckets) {
+            buckets.append(bucket);
+        }
+        histogram.insert("count", data.count);
+        histogram.insert("sum", data.sum);
+        histogram.insert("max", data.max);
+        histogram.insert("bounds", bounds);
+        histogram.insert("buckets", buckets);
+        map.insert(HISTOGRAM_NAMES[i], histogram);
+    }
+    return map;
+}
+
+QString OpenHABMetrics::toString() const {
+    QStringList parts;
+
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        parts.append(QString("%1=%2").arg(COUNTER_NAMES[i]).arg(_counters[i]));
+    }
+    for (int i = 0; i < HISTOGRAM_COUNT; ++i) {
+        const HistogramData& data = _histograms[i];
+        QStringList          buckets;
+        for (qint64 bucket : data.buckets) {
+            buckets.append(QString::number(bucket));
+        }
+        parts.append(QString("%1={count=%2 avg=%3ms max=%4ms buckets=%5}")
+                         .arg(HISTOGRAM_NAMES[i])
+                         .arg(data.count)
+                         .arg(data.count > 0 ? data.sum / data.count : 0)
+                         .arg(data.max)
+                         .arg(buckets.join('/')));
+    }
+    return parts.join(' ');
+}
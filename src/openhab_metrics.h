@@ -0,0 +1,96 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QVariantMap>
+
+/**
+ * @brief Counters and latency histograms of the integration.
+ *
+ * Recording is a few integer operations, so the metrics are always on. The histograms use fixed bucket bounds in ms.
+ * All methods must be called on the thread of the integration.
+ */
+class OpenHABMetrics {
+ public:
+    enum Counter {
+        SSE_BYTES,
+        SSE_EVENTS,
+        SSE_PARTIAL_FRAMES,  // chunks which ended inside an event, the event is reassembled from the next chunk
+        SSE_RECONNECTS,
+        RESYNC_ITEMS,      // items refreshed after the event stream was down
+        RESYNC_CORRECTED,  // entities which had a wrong state after the event stream was down
+        EVENTS_UNCONFIGURED,
+        EVENTS_REPEATED,
+        EVENTS_PROCESSED,
+        JSON_ERRORS,
+        PROBE_FAILURES,
+        COMMANDS,
+        COMMANDS_COALESCED,  // commands replaced by a newer command for the same item before they were sent
+        COMMANDS_DROPPED,    // commands discarded on disconnect or because they could not be sent
+        UPDATES_APPLIED,     // entity changes handed to the main thread
+        UPDATES_COALESCED,   // entity changes replaced by a newer value within one batch
+        UPDATES_SUPPRESSED,  // entity changes dropped because the entity already had the value
+        COUNTER_COUNT
+    };
+
+    enum Histogram {
+        COMMAND_ROUND_TRIP,  // POST of a command to the SSE state event of the item
+        ITEMS_READ,          // request and processing of the items list
+        SSE_OUTAGE,          // last data of a lost event stream to the new stream being open
+        HISTOGRAM_COUNT
+    };
+
+    void add(Counter counter, qint64 value = 1) { _counters[counter] += value; }
+    void set(Counter counter, qint64 value) { _counters[counter] = value; }
+    void record(Histogram histogram, qint64 ms);
+
+    qint64 counter(Counter counter) const { return _counters[counter]; }
+
+    /**
+     * @brief Returns all metrics, histograms as map with count, sum, max and the bucket counts
+     */
+    QVariantMap toVariantMap() const;
+
+    /**
+     * @brief Returns the metrics as one line for the log
+     */
+    QString toString() const;
+
+ private:
+    static const int BUCKET_COUNT = 12;  // including the overflow bucket
+
+    struct HistogramData {
+        qint64 buckets[BUCKET_COUNT] = {};
+        qint64 count = 0;
+        qint64 sum = 0;
+        qint64 max = 0;
+    };
+
+    static const int   BUCKET_BOUNDS[BUCKET_COUNT - 1];
+    static const char* COUNTER_NAMES[COUNTER_COUNT];
+    static const char* HISTOGRAM_NAMES[HISTOGRAM_COUNT];
+
+    qint64        _counters[COUNTER_COUNT] = {};
+    HistogramData _histograms[HISTOGRAM_COUNT];
+};
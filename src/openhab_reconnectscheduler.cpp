@@ -0,0 +1,55 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_reconnectscheduler.h"
+
+#include <QRandomGenerator>
+
+OpenHABReconnectScheduler::OpenHABReconnectScheduler(int initialDelay, int maxDelay, QObject* parent)
+    : QObject(parent), _timer(new QTimer(this)), _initialDelay(initialDelay), _maxDelay(maxDelay) {
+    _timer->setSingleShot(true);
+    QObject::connect(_timer, &QTimer::timeout, this, &OpenHABReconnectScheduler::attempt);
+}
+
+void OpenHABReconnectScheduler::schedule() {
+    if (_timer->isActive()) {
+        return;
+    }
+    int delay = _initialDelay;
+    for (int i = 0; i < _attempts && delay < _maxDelay; ++i) {
+        delay *= 2;
+    }
+    delay = qMin(delay, _maxDelay);
+    // equal jitter: keep half of the delay, randomize the other half
+    delay = delay / 2 + QRandomGenerator::global()->bounded(delay / 2 + 1);
+
+    _attempts++;
+    _nextAttempt = QDateTime::currentDateTime().addMSecs(delay);
+    _timer->start(delay);
+}
+
+void OpenHABReconnectScheduler::reset() {
+    _timer->stop();
+    _attempts = 0;
+}
+
+void OpenHABReconnectScheduler::cancel() { _timer->stop(); }
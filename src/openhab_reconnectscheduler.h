@@ -0,0 +1,69 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QDateTime>
+#include <QObject>
+#include <QTimer>
+
+/**
+ * @brief Schedules reconnection attempts with exponential backoff and jitter.
+ *
+ * The delay starts at the initial delay and doubles with every failed attempt up to the maximum delay. Half of the
+ * delay is randomized, so many remotes don't hit a restarting openHAB server at the same time.
+ */
+class OpenHABReconnectScheduler : public QObject {
+    Q_OBJECT
+
+ public:
+    explicit OpenHABReconnectScheduler(int initialDelay, int maxDelay, QObject* parent = nullptr);
+
+    /**
+     * @brief Schedules the next attempt after a failure. Does nothing if an attempt is already scheduled.
+     */
+    void schedule();
+
+    /**
+     * @brief Connection succeeded: cancels a scheduled attempt and restarts the backoff.
+     */
+    void reset();
+
+    /**
+     * @brief Cancels a scheduled attempt but keeps the backoff state.
+     */
+    void cancel();
+
+    int       attempts() const { return _attempts; }
+    bool      isScheduled() const { return _timer->isActive(); }
+    QDateTime nextAttempt() const { return _timer->isActive() ? _nextAttempt : QDateTime(); }
+
+ signals:
+    void attempt();
+
+ private:
+    QTimer*   _timer;
+    int       _initialDelay;
+    int       _maxDelay;
+    int       _attempts = 0;
+    QDateTime _nextAttempt;
+};
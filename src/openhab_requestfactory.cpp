@@ -0,0 +1,80 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_requestfactory.h"
+
+#include <QSslConfiguration>
+#include <QUrl>
+#include <QtGlobal>
+
+OpenHABRequestFactory::OpenHABRequestFactory(const QString& url, const QString& token) : _url(url) {
+    QNetworkRequest request;
+
+    request.setHeader(QNetworkRequest::UserAgentHeader, "Yio Remote OpenHAB Plugin");
+    if (!token.isEmpty()) {
+        request.setRawHeader("Authorization", "Bearer " + token.toUtf8());
+    }
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    if (url.startsWith("https", Qt::CaseInsensitive)) {
+        // resume TLS sessions when a connection has to be opened again, e.g. after standby
+        QSslConfiguration ssl = QSslConfiguration::defaultConfiguration();
+        ssl.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+        request.setSslConfiguration(ssl);
+    }
+
+    _events = request;
+    _events.setRawHeader("Accept", "text/event-stream");
+    _events.setAttribute(QNetworkRequest::CacheLoadControlAttribute,
+                         QNetworkRequest::AlwaysNetwork);  // Events shouldn't be cached
+
+    // the event stream stays on its own HTTP/1.1 connection, aborting it doesn't reset the connection of the
+    // commands. Other requests share one multiplexed connection if the server supports HTTP/2.
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+#else
+    request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+#endif
+
+    _json = request;
+    _json.setRawHeader("Accept", "application/json");
+
+    _command = request;
+    _command.setHeader(QNetworkRequest::ContentTypeHeader, "text/plain");
+}
+
+QNetworkRequest OpenHABRequestFactory::json(const QString& path) const {
+    QNetworkRequest request(_json);
+    request.setUrl(QUrl(_url + path));
+    return request;
+}
+
+QNetworkRequest OpenHABRequestFactory::command(const QString& item) const {
+    QNetworkRequest request(_command);
+    request.setUrl(QUrl(_url + "items/" + item));
+    return request;
+}
+
+QNetworkRequest OpenHABRequestFactory::events(const QString& topics) const {
+    QNetworkRequest request(_events);
+    request.setUrl(QUrl(topics.isEmpty() ? _url + "events" : _url + "events?topics=" + topics));
+    return request;
+}
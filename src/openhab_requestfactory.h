@@ -0,0 +1,60 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QNetworkRequest>
+#include <QString>
+
+/**
+ * @brief Creates the requests to the openHAB REST API.
+ *
+ * The headers and attributes are set up once, a request is a copy of a prebuilt prototype with the URL of the call.
+ */
+class OpenHABRequestFactory {
+ public:
+    OpenHABRequestFactory() = default;
+    OpenHABRequestFactory(const QString& url, const QString& token);
+
+    /**
+     * @brief GET request for a JSON resource, e.g. "items" or "systeminfo"
+     */
+    QNetworkRequest json(const QString& path) const;
+
+    /**
+     * @brief POST request which sends a command to an item
+     */
+    QNetworkRequest command(const QString& item) const;
+
+    /**
+     * @brief GET request for the server sent events, all events if topics is empty
+     */
+    QNetworkRequest events(const QString& topics) const;
+
+    const QString& url() const { return _url; }
+
+ private:
+    QString         _url;
+    QNetworkRequest _json;
+    QNetworkRequest _command;
+    QNetworkRequest _events;
+};
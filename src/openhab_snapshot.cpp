@@ -0,0 +1,92 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_snapshot.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+static const quint32 SNAPSHOT_MAGIC = 0x4f485353;  // "OHSS"
+static const quint16 SNAPSHOT_VERSION = 2;
+
+bool OpenHABSnapshot::write(const QString& path, const QString& url, const QVector<Record>& records) {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << SNAPSHOT_MAGIC << SNAPSHOT_VERSION << QDateTime::currentMSecsSinceEpoch() << url
+        << static_cast<quint32>(records.size());
+    for (const Record& record : records) {
+        out << record.item << record.entityId << record.attribute << record.channel << record.state << record.type;
+    }
+    if (out.status() != QDataStream::Ok) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+bool OpenHABSnapshot::read(const QString& path, const QString& url, int maxAge, QVector<Record>* records) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+        return false;
+    }
+    uchar* data = file.map(0, file.size());
+    if (data == nullptr) {
+        return false;
+    }
+    // the stream reads directly from the mapped file
+    QByteArray  bytes = QByteArray::fromRawData(reinterpret_cast<const char*>(data), static_cast<int>(file.size()));
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    qint64  created = 0;
+    QString snapshotUrl;
+    quint32 count = 0;
+    in >> magic >> version >> created >> snapshotUrl >> count;
+
+    qint64 age = QDateTime::currentMSecsSinceEpoch() - created;
+    bool   valid = in.status() == QDataStream::Ok && magic == SNAPSHOT_MAGIC && version == SNAPSHOT_VERSION &&
+                 snapshotUrl == url && age >= 0 && age <= qint64(maxAge) * 1000;
+    if (valid) {
+        records->clear();
+        records->reserve(static_cast<int>(qMin(count, quint32(bytes.size()))));
+        for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+            Record record;
+            in >> record.item >> record.entityId >> record.attribute >> record.channel >> record.state >> record.type;
+            records->append(record);
+        }
+        valid = in.status() == QDataStream::Ok;
+    }
+    file.unmap(data);
+    return valid;
+}
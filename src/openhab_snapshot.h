@@ -0,0 +1,57 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Last known item states and item bindings of the integration, stored on disk.
+ *
+ * The snapshot is written when the remote goes to standby or disconnects and applied on the next start before openHAB
+ * is reachable. It is a QDataStream with a small header: magic, format version, creation time and the openHAB URL.
+ * A snapshot of another server, of another format or older than the maximum age is ignored.
+ */
+class OpenHABSnapshot {
+ public:
+    struct Record {
+        QString    item;
+        QString    entityId;
+        qint32     attribute = -1;  // YIO attribute of a thing channel item, -1 for the entity item
+        QString    channel;         // channel id of a thing channel item
+        QByteArray state;           // raw openHAB state, empty if unknown
+        QByteArray type;            // openHAB item type, empty if unknown
+    };
+
+    /**
+     * @brief Writes the snapshot atomically, returns false on I/O errors
+     */
+    static bool write(const QString& path, const QString& url, const QVector<Record>& records);
+
+    /**
+     * @brief Memory maps and reads the snapshot. Returns false if there is none or if it is invalid, of another
+     *        server or older than maxAge seconds.
+     */
+    static bool read(const QString& path, const QString& url, int maxAge, QVector<Record>* records);
+};
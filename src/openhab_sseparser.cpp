@@ -0,0 +1,143 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_sseparser.h"
+
+#include <cstring>
+
+void OpenHABSseParser::append(const QByteArray& chunk) {
+    _buffer.append(chunk);
+
+    // a stream may start with an UTF-8 byte order mark which is not part of the first field
+    if (_streamStart) {
+        if (_buffer.size() < 3 && QByteArray("\xEF\xBB\xBF").startsWith(_buffer)) {
+            return;
+        }
+        if (_buffer.startsWith("\xEF\xBB\xBF")) {
+            _buffer.remove(0, 3);
+        }
+        _streamStart = false;
+    }
+
+    const char* data = _buffer.constData();
+    const int   size = _buffer.size();
+    int         lineStart = 0;
+    int         pos = _scanPos;
+
+    while (pos < size) {
+        const char c = data[pos];
+        if (c != '\n' && c != '\r') {
+            ++pos;
+            continue;
+        }
+        // a CR at the end of the buffer may be the first half of a CRLF
+        if (c == '\r' && pos + 1 == size) {
+            break;
+        }
+        processLine(data + lineStart, pos - lineStart);
+        if (c == '\r' && data[pos + 1] == '\n') {
+            ++pos;
+        }
+        lineStart = ++pos;
+    }
+
+    if (lineStart > 0) {
+        _buffer.remove(0, lineStart);
+    }
+    _scanPos = pos - lineStart;
+}
+
+bool OpenHABSseParser::takeEvent(Event* event) {
+    if (_events.isEmpty()) {
+        return false;
+    }
+    *event = _events.dequeue();
+    return true;
+}
+
+void OpenHABSseParser::reset() {
+    _buffer.clear();
+    _scanPos = 0;
+    _streamStart = true;
+    _eventType.clear();
+    _data.clear();
+    _hasData = false;
+    _events.clear();
+}
+
+void OpenHABSseParser::processLine(const char* line, int length) {
+    if (length == 0) {
+        dispatchEvent();
+        return;
+    }
+    if (line[0] == ':') {
+        // comment, used by servers as keep alive
+        return;
+    }
+
+    const char* colon = static_cast<const char*>(memchr(line, ':', length));
+    int         fieldLength = colon ? static_cast<int>(colon - line) : length;
+    const char* value = colon ? colon + 1 : line + length;
+    int         valueLength = static_cast<int>(line + length - value);
+    if (valueLength > 0 && value[0] == ' ') {
+        ++value;
+        --valueLength;
+    }
+
+    if (fieldLength == 4 && strncmp(line, "data", 4) == 0) {
+        _data.append(value, valueLength);
+        _data.append('\n');
+        _hasData = true;
+    } else if (fieldLength == 5 && strncmp(line, "event", 5) == 0) {
+        _eventType = QByteArray(value, valueLength);
+    } else if (fieldLength == 2 && strncmp(line, "id", 2) == 0) {
+        if (memchr(value, '\0', valueLength) == nullptr) {
+            _lastEventId = QByteArray(value, valueLength);
+        }
+    } else if (fieldLength == 5 && strncmp(line, "retry", 5) == 0) {
+        bool ok = false;
+        int  retry = QByteArray::fromRawData(value, valueLength).toInt(&ok);
+        if (ok && retry >= 0 && valueLength > 0 && value[0] != '+' && value[0] != '-') {
+            _retry = retry;
+        }
+    }
+    // other fields are ignored
+}
+
+void OpenHABSseParser::dispatchEvent() {
+    if (!_hasData) {
+        _eventType.clear();
+        return;
+    }
+    // remove the line feed of the last data line
+    _data.chop(1);
+
+    Event event;
+    event.type = _eventType.isEmpty() ? QByteArray("message") : _eventType;
+    event.data = _data;
+    event.id = _lastEventId;
+    _events.enqueue(event);
+
+    _eventType.clear();
+    _data.clear();
+    _hasData = false;
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QQueue>
+
+/**
+ * @brief Incremental text/event-stream parser.
+ *
+ * Received bytes are appended to a single buffer which is scanned once for line ends. Fields are collected
+ * according to the SSE specification and an event is only handed out after the blank line terminating it.
+ */
+class OpenHABSseParser {
+ public:
+    struct Event {
+        QByteArray type;  // "message" if the event has no event field
+        QByteArray data;  // data lines joined with '\n'
+        QByteArray id;    // last event id at the time of dispatch
+    };
+
+    /**
+     * @brief Appends a received chunk and parses all complete lines in it.
+     */
+    void append(const QByteArray& chunk);
+
+    /**
+     * @brief Takes the next complete event. Returns false if no complete event is available.
+     */
+    bool takeEvent(Event* event);
+
+    /**
+     * @brief Discards all buffered data, e.g. when the stream is reconnected.
+     */
+    void reset();
+
+    /**
+     * @brief Returns true if the received data ends inside an event which is completed by the next chunk.
+     */
+    bool hasPartialEvent() const { return !_buffer.isEmpty() || _hasData || !_eventType.isEmpty(); }
+
+    const QByteArray& lastEventId() const { return _lastEventId; }
+
+    /**
+     * @brief Reconnection time in ms sent by the server or -1 if not set.
+     */
+    int retry() const { return _retry; }
+
+ private:
+    void processLine(const char* line, int length);
+    void dispatchEvent();
+
+    QByteArray    _buffer;
+    int           _scanPos = 0;
+    bool          _streamStart = true;
+    QByteArray    _eventType;
+    QByteArray    _data;
+    bool          _hasData = false;
+    QByteArray    _lastEventId;
+    int           _retry = -1;
+    QQueue<Event> _events;
+};
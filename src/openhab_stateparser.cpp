@@ -0,0 +1,173 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "openhab_stateparser.h"
+
+namespace {
+
+inline ushort unicode(char c) { return static_cast<uchar>(c); }
+inline ushort unicode(QChar c) { return c.unicode(); }
+
+template <typename Char>
+bool equals(const Char* data, int size, const char* literal) {
+    int i = 0;
+    for (; i < size && literal[i] != '\0'; ++i) {
+        if (unicode(data[i]) != static_cast<uchar>(literal[i])) {
+            return false;
+        }
+    }
+    return i == size && literal[i] == '\0';
+}
+
+// Parses a plain decimal number like "-12.50" starting at pos. Returns the position after the number or -1.
+template <typename Char>
+int parseNumber(const Char* data, int size, int pos, double* value) {
+    bool   negative = false;
+    bool   digits = false;
+    double result = 0;
+
+    if (pos < size && (unicode(data[pos]) == '-' || unicode(data[pos]) == '+')) {
+        negative = unicode(data[pos]) == '-';
+        ++pos;
+    }
+    for (; pos < size && unicode(data[pos]) >= '0' && unicode(data[pos]) <= '9'; ++pos) {
+        result = result * 10 + (unicode(data[pos]) - '0');
+        digits = true;
+    }
+    if (pos < size && unicode(data[pos]) == '.') {
+        double scale = 0.1;
+        for (++pos; pos < size && unicode(data[pos]) >= '0' && unicode(data[pos]) <= '9'; ++pos) {
+            result += (unicode(data[pos]) - '0') * scale;
+            scale /= 10;
+            digits = true;
+        }
+    }
+    if (!digits) {
+        return -1;
+    }
+    *value = negative ? -result : result;
+    return pos;
+}
+
+template <typename Char>
+OpenHABState parseLiteral(const Char* data, int size, bool percentType) {
+    OpenHABState state;
+
+    if (size <= 0) {
+        return state;
+    }
+
+    switch (unicode(data[0])) {
+        case 'O':
+            if (equals(data, size, "ON")) {
+                state.type = OpenHABState::ON_OFF;
+                state.on = true;
+            } else if (equals(data, size, "OFF")) {
+                state.type = OpenHABState::ON_OFF;
+            }
+            return state;
+        case 'U':
+            if (equals(data, size, "UP")) {
+                state.type = OpenHABState::UP_DOWN;
+                state.on = true;
+            } else if (equals(data, size, "UNDEF")) {
+                state.type = OpenHABState::UNDEF;
+            }
+            return state;
+        case 'D':
+            if (equals(data, size, "DOWN")) {
+                state.type = OpenHABState::UP_DOWN;
+            }
+            return state;
+        case 'N':
+            if (equals(data, size, "NULL")) {
+                state.type = OpenHABState::NULL_STATE;
+            }
+            return state;
+        default:
+            break;
+    }
+
+    double number;
+    int    pos = parseNumber(data, size, 0, &number);
+    if (pos < 0) {
+        return state;
+    }
+
+    // HSBType: "hue,saturation,brightness"
+    if (pos < size && unicode(data[pos]) == ',') {
+        double saturation;
+        double brightness;
+        pos = parseNumber(data, size, pos + 1, &saturation);
+        if (pos < 0 || pos >= size || unicode(data[pos]) != ',') {
+            return state;
+        }
+        pos = parseNumber(data, size, pos + 1, &brightness);
+        if (pos != size) {
+            return state;
+        }
+        state.type = OpenHABState::HSB;
+        state.hue = number;
+        state.saturation = saturation;
+        state.brightness = brightness;
+        return state;
+    }
+
+    // QuantityType: number followed by a space and the unit, e.g. "21.5 °C"
+    if (pos < size && unicode(data[pos]) != ' ') {
+        return state;
+    }
+    state.number = number;
+    bool percent = percentType && pos == size && number >= 0 && number <= 100;
+    state.type = percent ? OpenHABState::PERCENT : OpenHABState::DECIMAL;
+    return state;
+}
+
+}  // namespace
+
+QString OpenHABState::toString() const {
+    if (rawUtf16) {
+        return QString(static_cast<const QChar*>(raw), rawSize);
+    }
+    return QString::fromUtf8(static_cast<const char*>(raw), rawSize);
+}
+
+OpenHABState OpenHABStateParser::parse(const char* data, int size, const QByteArray& type) {
+    OpenHABState state = parseLiteral(data, size, isPercentType(type));
+    state.raw = data;
+    state.rawSize = size;
+    state.rawUtf16 = false;
+    return state;
+}
+
+OpenHABState OpenHABStateParser::parse(const QString& data, const QByteArray& type) {
+    OpenHABState state = parseLiteral(data.constData(), data.size(), isPercentType(type));
+    state.raw = data.constData();
+    state.rawSize = data.size();
+    state.rawUtf16 = true;
+    return state;
+}
+
+bool OpenHABStateParser::isPercentType(const QByteArray& type) {
+    // value type of the events first, they are parsed most often
+    return type == "Percent" || type == "Dimmer" || type == "Rollershutter" || type == "Color";
+}
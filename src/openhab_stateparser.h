@@ -0,0 +1,82 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+/**
+ * @brief Typed value of an openHAB state literal.
+ *
+ * The raw literal is referenced, not copied: it's only valid as long as the parsed data.
+ */
+struct OpenHABState {
+    enum Type {
+        STRING,      // any other literal
+        UNDEF,       // UnDefType UNDEF
+        NULL_STATE,  // UnDefType NULL
+        ON_OFF,      // OnOffType
+        UP_DOWN,     // UpDownType
+        PERCENT,     // PercentType, a number between 0 and 100 of a Dimmer, Rollershutter or Color item
+        DECIMAL,     // DecimalType or QuantityType, a number with optional unit
+        HSB          // HSBType "h,s,b"
+    };
+
+    Type   type = STRING;
+    bool   on = false;  // ON or UP
+    double number = 0;  // value of PERCENT and DECIMAL
+    double hue = 0;
+    double saturation = 0;
+    double brightness = 0;
+
+    bool isNumber() const { return type == PERCENT || type == DECIMAL; }
+    bool isUndefined() const { return type == UNDEF || type == NULL_STATE; }
+
+    /**
+     * @brief Returns the raw literal, e.g. for string items
+     */
+    QString toString() const;
+
+    const void* raw = nullptr;
+    int         rawSize = 0;
+    bool        rawUtf16 = false;
+};
+
+/**
+ * @brief Single pass parser for openHAB state literals, it doesn't allocate memory.
+ */
+class OpenHABStateParser {
+ public:
+    /**
+     * @brief Parses a state literal. type is the openHAB item type, e.g. "Dimmer" or "Number", or the value type of an
+     *        event, e.g. "Percent" or "Decimal": a plain number is only a PERCENT for the types of isPercentType(),
+     *        otherwise and without a type it's a DECIMAL.
+     */
+    static OpenHABState parse(const char* data, int size, const QByteArray& type = QByteArray());
+    static OpenHABState parse(const QByteArray& data, const QByteArray& type = QByteArray()) {
+        return parse(data.constData(), data.size(), type);
+    }
+    static OpenHABState parse(const QString& data, const QByteArray& type = QByteArray());
+
+    static bool isPercentType(const QByteArray& type);
+};
@@ -0,0 +1,9 @@
+TEMPLATE = subdirs
+SUBDIRS  = \
+    eventdecoder \
+    itemsreader \
+    jsonscanner \
+    openhab \
+    snapshot \
+    sseparser \
+    stateparser
@@ -0,0 +1,8 @@
+include(../../tests.pri)
+
+TARGET   = tst_eventdecoder
+HEADERS += $$SRC_PATH/openhab_eventdecoder.h \
+    $$SRC_PATH/openhab_jsonscanner.h
+SOURCES += $$SRC_PATH/openhab_eventdecoder.cpp \
+    $$SRC_PATH/openhab_jsonscanner.cpp \
+    tst_eventdecoder.cpp
@@ -0,0 +1,276 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include <QtTest>
+
+#include "openhab_eventdecoder.h"
+
+Q_DECLARE_METATYPE(OpenHABEventDecoder::Type)
+
+class TestEventDecoder : public QObject {
+    Q_OBJECT
+
+ private slots:
+    void decode_data();
+    void decode();
+    void escapedTopic();
+    void nestedPayload();
+    void surrogatePair();
+    void truncated();
+    void invalid_data();
+    void invalid();
+    void otherEvents();
+    void peekItem_data();
+    void peekItem();
+    void itemFromTopic_data();
+    void itemFromTopic();
+    void reusedBuffers();
+
+ private:
+    static QByteArray event(const QByteArray& topic, const QByteArray& payload, const QByteArray& type);
+};
+
+QByteArray TestEventDecoder::event(const QByteArray& topic, const QByteArray& payload, const QByteArray& type) {
+    QByteArray escaped = payload;
+    escaped.replace('\\', "\\\\").replace('"', "\\\"");
+    return "{\"topic\":\"" + topic + "\",\"payload\":\"" + escaped + "\",\"type\":\"" + type + "\"}";
+}
+
+void TestEventDecoder::decode_data() {
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<OpenHABEventDecoder::Type>("type");
+    QTest::addColumn<QByteArray>("item");
+    QTest::addColumn<QByteArray>("valueType");
+    QTest::addColumn<QByteArray>("value");
+
+    QTest::newRow("ItemStateEvent") << event("openhab/items/Light/state", "{\"type\":\"OnOff\",\"value\":\"ON\"}",
+                                             "ItemStateEvent")
+                                    << OpenHABEventDecoder::ITEM_STATE << QByteArray("Light") << QByteArray("OnOff")
+                                    << QByteArray("ON");
+    QTest::newRow("openHAB 2 namespace")
+        << event("smarthome/items/Dimmer/state", "{\"type\":\"Percent\",\"value\":\"42\"}", "ItemStateEvent")
+        << OpenHABEventDecoder::ITEM_STATE << QByteArray("Dimmer") << QByteArray("Percent") << QByteArray("42");
+    QTest::newRow("ItemStateChangedEvent")
+        << event("openhab/items/Dimmer/statechanged",
+                 "{\"type\":\"Percent\",\"value\":\"42\",\"oldType\":\"Percent\",\"oldValue\":\"10\"}",
+                 "ItemStateChangedEvent")
+        << OpenHABEventDecoder::ITEM_STATE_CHANGED << QByteArray("Dimmer") << QByteArray("Percent")
+        << QByteArray("42");
+    // the group is the third part of the topic, the member the fourth
+    QTest::newRow("GroupItemStateChangedEvent")
+        << event("openhab/items/gLights/Light_Kitchen/statechanged",
+                 "{\"type\":\"OnOff\",\"value\":\"ON\",\"oldType\":\"OnOff\",\"oldValue\":\"OFF\"}",
+                 "GroupItemStateChangedEvent")
+        << OpenHABEventDecoder::GROUP_ITEM_STATE_CHANGED << QByteArray("gLights") << QByteArray("OnOff")
+        << QByteArray("ON");
+    QTest::newRow("members in other order")
+        << QByteArray("{\"type\":\"ItemStateEvent\",\"payload\":\"{\\\"value\\\":\\\"1,2,3\\\",\\\"type\\\":"
+                      "\\\"HSB\\\"}\",\"topic\":\"openhab/items/Color/state\"}")
+        << OpenHABEventDecoder::ITEM_STATE << QByteArray("Color") << QByteArray("HSB") << QByteArray("1,2,3");
+    QTest::newRow("whitespace")
+        << QByteArray(" {\n \"topic\" : \"openhab/items/A/state\" ,\n \"payload\" : \"{ \\\"type\\\" : "
+                      "\\\"Decimal\\\" , \\\"value\\\" : \\\"5\\\" }\" , \"type\" : \"ItemStateEvent\" } ")
+        << OpenHABEventDecoder::ITEM_STATE << QByteArray("A") << QByteArray("Decimal") << QByteArray("5");
+    QTest::newRow("escaped value")
+        << event("openhab/items/Title/state", "{\"type\":\"String\",\"value\":\"say \\\"hi\\\"\\n\"}",
+                 "ItemStateEvent")
+        << OpenHABEventDecoder::ITEM_STATE << QByteArray("Title") << QByteArray("String")
+        << QByteArray("say \"hi\"\n");
+}
+
+void TestEventDecoder::decode() {
+    QFETCH(QByteArray, data);
+    QFETCH(OpenHABEventDecoder::Type, type);
+    QFETCH(QByteArray, item);
+    QFETCH(QByteArray, valueType);
+    QFETCH(QByteArray, value);
+    OpenHABEventDecoder        decoder;
+    OpenHABEventDecoder::Event decoded;
+
+    QVERIFY(decoder.decode(data, &decoded));
+    QCOMPARE(decoded.type, type);
+    QCOMPARE(decoded.item, item);
+    QCOMPARE(decoded.valueType, valueType);
+    QCOMPARE(decoded.value, value);
+}
+
+void TestEventDecoder::escapedTopic() {
+    OpenHABEventDecoder        decoder;
+    OpenHABEventDecoder::Event decoded;
+    QByteArray                 data =
+        event("openhab\\/items\\/Light_\\u00dc\\/state", "{\"type\":\"OnOff\",\"value\":\"OFF\"}", "ItemStateEvent");
+
+    // the pre-filter can't read escaped topics, the event must not be dropped
+    QVERIFY(OpenHABEventDecoder::peekItem(data).isEmpty());
+    QVERIFY(decoder.decode(data, &decoded));
+    QCOMPARE(decoded.item, QByteArray("Light_\xC3\x9C"));
+    QCOMPARE(decoded.value, QByteArray("OFF"));
+}
+
+void TestEventDecoder::nestedPayload() {
+    // nested members with the same names must not be taken for the state
+    QByteArray data = event("openhab/items/Player/state",
+                            "{\"type\":\"String\",\"meta\":{\"value\":\"wrong\",\"list\":[1,{\"type\":\"}\"}]},"
+                            "\"value\":\"right\"}",
+                            "ItemStateEvent");
+    OpenHABEventDecoder        decoder;
+    OpenHABEventDecoder::Event decoded;
+
+    QVERIFY(decoder.decode(data, &decoded));
+    QCOMPARE(decoded.valueType, QByteArray("String"));
+    QCOMPARE(decoded.value, QByteArray("right"));
+
+    // an object as envelope member is skipped as well
+    data = "{\"topic\":\"openhab/items/A/state\",\"extra\":{\"payload\":\"x\",\"a\":[{}]},"
+           "\"payload\":\"{\\\"type\\\":\\\"OnOff\\\",\\\"value\\\":\\\"ON\\\"}\",\"type\":\"ItemStateEvent\"}";
+    QVERIFY(decoder.decode(data, &decoded));
+    QCOMPARE(decoded.value, QByteArray("ON"));
+}
+
+void TestEventDecoder::surrogatePair() {
+    OpenHABEventDecoder        decoder;
+    OpenHABEventDecoder::Event decoded;
+
+    // escaped in the payload document, i.e. escaped twice in the message
+    QByteArray data = event("openhab/items/Title/state", "{\"type\":\"String\",\"value\":\"\\uD83D\\uDE00!\"}",
+                            "ItemStateEvent");
+    QVERIFY(data.contains("\\\\uD83D\\\\uDE00"));
+    QVERIFY(decoder.decode(data, &decoded));
+    QCOMPARE(decoded.value, QByteArray("\xF0\x9F\x98\x80!"));
+
+    // escaped in the message only
+    data = "{\"topic\":\"openhab/items/Title/state\",\"payload\":\"{\\\"type\\\":\\\"String\\\",\\\"value\\\":"
+           "\\\"\\uD83D\\uDE00!\\\"}\",\"type\":\"ItemStateEvent\"}";
+    QVERIFY(decoder.decode(data, &decoded));
+    QCOMPARE(decoded.value, QByteArray("\xF0\x9F\x98\x80!"));
+}
+
+void TestEventDecoder::truncated() {
+    OpenHABEventDecoder        decoder;
+    OpenHABEventDecoder::Event decoded;
+    QByteArray                 data =
+        event("openhab/items/gRooms/Room/statechanged",
+              "{\"type\":\"String\",\"value\":\"K\\u00fcche\",\"oldType\":\"String\",\"oldValue\":\"Bad\"}",
+              "GroupItemStateChangedEvent");
+
+    QVERIFY(decoder.decode(data, &decoded));
+    // every shorter message is incomplete and must be rejected, without reading beyond the data
+    for (int size = 0; size < data.size(); ++size) {
+        QByteArray prefix(data.constData(), size);
+        QVERIFY2(!decoder.decode(prefix, &decoded), prefix.constData());
+        OpenHABEventDecoder::peekItem(prefix);
+    }
+}
+
+void TestEventDecoder::invalid_data() {
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("no object") << QByteArray("ItemStateEvent");
+    QTest::newRow("no type") << QByteArray("{\"topic\":\"openhab/items/A/state\",\"payload\":\"{}\"}");
+    QTest::newRow("no payload") << QByteArray("{\"topic\":\"openhab/items/A/state\",\"type\":\"ItemStateEvent\"}");
+    QTest::newRow("no value") << event("openhab/items/A/state", "{\"type\":\"OnOff\"}", "ItemStateEvent");
+    QTest::newRow("payload no object") << event("openhab/items/A/state", "ON", "ItemStateEvent");
+    QTest::newRow("truncated payload") << event("openhab/items/A/state", "{\"type\":\"OnOff\",\"value\":\"ON\"",
+                                                "ItemStateEvent");
+}
+
+void TestEventDecoder::invalid() {
+    QFETCH(QByteArray, data);
+    OpenHABEventDecoder        decoder;
+    OpenHABEventDecoder::Event decoded;
+
+    QVERIFY(!decoder.decode(data, &decoded));
+}
+
+void TestEventDecoder::otherEvents() {
+    OpenHABEventDecoder        decoder;
+    OpenHABEventDecoder::Event decoded;
+
+    // valid events which are not state updates are accepted without decoding the payload
+    QVERIFY(decoder.decode(
+        event("openhab/items/A/command", "{\"type\":\"OnOff\",\"value\":\"ON\"}", "ItemCommandEvent"), &decoded));
+    QCOMPARE(decoded.type, OpenHABEventDecoder::UNKNOWN);
+    QVERIFY(decoder.decode(event("openhab/things/hue:0210:1/status", "{\"status\":\"ONLINE\"}",
+                                 "ThingStatusInfoEvent"),
+                           &decoded));
+    QCOMPARE(decoded.type, OpenHABEventDecoder::UNKNOWN);
+    QVERIFY(decoded.item.isEmpty());
+}
+
+void TestEventDecoder::peekItem_data() {
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QByteArray>("item");
+
+    QTest::newRow("state") << event("openhab/items/Light/state", "{}", "ItemStateEvent") << QByteArray("Light");
+    QTest::newRow("group") << event("openhab/items/gAll/Light/statechanged", "{}", "GroupItemStateChangedEvent")
+                           << QByteArray("gAll");
+    QTest::newRow("whitespace") << QByteArray("{ \"topic\" :  \"openhab/items/A/state\" }") << QByteArray("A");
+    QTest::newRow("escaped") << QByteArray("{\"topic\":\"openhab\\/items\\/A\\/state\"}") << QByteArray();
+    QTest::newRow("no topic") << QByteArray("{\"type\":\"ALIVE\"}") << QByteArray();
+    QTest::newRow("topic no string") << QByteArray("{\"topic\":1}") << QByteArray();
+    QTest::newRow("truncated") << QByteArray("{\"topic\":\"openhab/items/A/st") << QByteArray();
+    QTest::newRow("thing") << QByteArray("{\"topic\":\"openhab/things/x:y:z/status\"}") << QByteArray("x:y:z");
+}
+
+void TestEventDecoder::peekItem() {
+    QFETCH(QByteArray, data);
+    QFETCH(QByteArray, item);
+
+    QCOMPARE(OpenHABEventDecoder::peekItem(data), item);
+}
+
+void TestEventDecoder::itemFromTopic_data() {
+    QTest::addColumn<QByteArray>("topic");
+    QTest::addColumn<QByteArray>("item");
+
+    QTest::newRow("state") << QByteArray("smarthome/items/Light/state") << QByteArray("Light");
+    QTest::newRow("no event") << QByteArray("openhab/items/Light") << QByteArray("Light");
+    QTest::newRow("group") << QByteArray("openhab/items/gAll/Light/statechanged") << QByteArray("gAll");
+    QTest::newRow("too short") << QByteArray("openhab/items") << QByteArray();
+    QTest::newRow("empty") << QByteArray() << QByteArray();
+}
+
+void TestEventDecoder::itemFromTopic() {
+    QFETCH(QByteArray, topic);
+    QFETCH(QByteArray, item);
+
+    QCOMPARE(OpenHABEventDecoder::itemFromTopic(topic), item);
+}
+
+void TestEventDecoder::reusedBuffers() {
+    OpenHABEventDecoder        decoder;
+    OpenHABEventDecoder::Event decoded;
+
+    // a short escaped value after a long one must not keep bytes of the previous event
+    QVERIFY(decoder.decode(event("openhab/items/A/state", "{\"type\":\"String\",\"value\":\"a long \\\"value\\\"\"}",
+                                 "ItemStateEvent"),
+                           &decoded));
+    QVERIFY(decoder.decode(event("openhab/items/B/state", "{\"type\":\"String\",\"value\":\"\\\"b\\\"\"}",
+                                 "ItemStateEvent"),
+                           &decoded));
+    QCOMPARE(decoded.item, QByteArray("B"));
+    QCOMPARE(decoded.value, QByteArray("\"b\""));
+}
+
+QTEST_APPLESS_MAIN(TestEventDecoder)
+
+#include "tst_eventdecoder.moc"
@@ -0,0 +1,8 @@
+include(../../tests.pri)
+
+TARGET   = tst_itemsreader
+HEADERS += $$SRC_PATH/openhab_itemsreader.h \
+    $$SRC_PATH/openhab_jsonscanner.h
+SOURCES += $$SRC_PATH/openhab_itemsreader.cpp \
+    $$SRC_PATH/openhab_jsonscanner.cpp \
+    tst_itemsreader.cpp
@@ -0,0 +1,184 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include <QtTest>
+
+#include "openhab_itemsreader.h"
+
+class TestItemsReader : public QObject {
+    Q_OBJECT
+
+ private slots:
+    void init();
+
+    void completeDocument();
+    void chunked_data();
+    void chunked();
+    void nestedMembers();
+    void escapedStrings();
+    void itemWithoutName();
+    void emptyArray();
+    void incompleteDocument();
+    void syntaxError_data();
+    void syntaxError();
+    void bufferOnlyHoldsOneItem();
+
+ private:
+    static QByteArray document(int count);
+
+    OpenHABItemsReader         _reader;
+    QList<QList<QByteArray> > _items;  // name, state and type of every item
+};
+
+void TestItemsReader::init() {
+    _items.clear();
+    _reader.reset();
+    _reader.setCallback([this](const OpenHABItemsReader::Item& item) {
+        // the views are only valid during the callback: copy them
+        _items.append(QList<QByteArray>() << QByteArray(item.name.constData(), item.name.size())
+                                          << QByteArray(item.state.constData(), item.state.size())
+                                          << QByteArray(item.type.constData(), item.type.size()));
+    });
+}
+
+QByteArray TestItemsReader::document(int count) {
+    QByteArray data("[");
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) {
+            data.append(',');
+        }
+        data.append("{\"link\":\"http://openhab:8080/rest/items/Item" + QByteArray::number(i) +
+                    "\",\"state\":\"" + QByteArray::number(i % 101) + "\",\"type\":\"Dimmer\",\"name\":\"Item" +
+                    QByteArray::number(i) + "\",\"groupNames\":[\"gLights\"],\"tags\":[]}");
+    }
+    data.append(']');
+    return data;
+}
+
+void TestItemsReader::completeDocument() {
+    QVERIFY(_reader.feed(document(3)));
+    QVERIFY(_reader.isComplete());
+    QCOMPARE(_reader.itemCount(), 3);
+    QCOMPARE(_items.size(), 3);
+    QCOMPARE(_items[2][0], QByteArray("Item2"));
+    QCOMPARE(_items[2][1], QByteArray("2"));
+    QCOMPARE(_items[2][2], QByteArray("Dimmer"));
+}
+
+void TestItemsReader::chunked_data() {
+    QTest::addColumn<int>("chunkSize");
+
+    QTest::newRow("1 byte") << 1;
+    QTest::newRow("7 bytes") << 7;
+    QTest::newRow("4 KB") << 4096;
+}
+
+void TestItemsReader::chunked() {
+    QFETCH(int, chunkSize);
+    QByteArray data = document(50);
+
+    for (int pos = 0; pos < data.size(); pos += chunkSize) {
+        QVERIFY(!_reader.isComplete());
+        QVERIFY(_reader.feed(data.mid(pos, chunkSize)));
+    }
+    QVERIFY(_reader.isComplete());
+    QCOMPARE(_items.size(), 50);
+    for (int i = 0; i < 50; ++i) {
+        QCOMPARE(_items[i][0], QByteArray("Item" + QByteArray::number(i)));
+        QCOMPARE(_items[i][1], QByteArray::number(i % 101));
+    }
+}
+
+void TestItemsReader::nestedMembers() {
+    // members of nested objects must not be taken for the members of the item
+    QVERIFY(_reader.feed(
+        "[{\"stateDescription\":{\"pattern\":\"%d %%\",\"options\":[{\"value\":\"1\",\"label\":\"}\"}]},"
+        "\"members\":[{\"name\":\"Member\",\"state\":\"ON\",\"type\":\"Switch\"}],"
+        "\"name\":\"Group\",\"state\":\"OFF\",\"type\":\"Group\"}]"));
+    QVERIFY(_reader.isComplete());
+    QCOMPARE(_items.size(), 1);
+    QCOMPARE(_items[0][0], QByteArray("Group"));
+    QCOMPARE(_items[0][1], QByteArray("OFF"));
+    QCOMPARE(_items[0][2], QByteArray("Group"));
+}
+
+void TestItemsReader::escapedStrings() {
+    QVERIFY(_reader.feed("[{\"name\":\"Text\",\"state\":\"say \\\"hi\\\" \\u00fc [\\\\]\",\"type\":\"String\"}]"));
+    QCOMPARE(_items.size(), 1);
+    QCOMPARE(_items[0][1], QByteArray("say \"hi\" \xC3\xBC [\\]"));
+}
+
+void TestItemsReader::itemWithoutName() {
+    QVERIFY(_reader.feed("[{\"state\":\"ON\"},{\"name\":\"A\"}]"));
+    QVERIFY(_reader.isComplete());
+    QCOMPARE(_reader.itemCount(), 1);
+    QCOMPARE(_items[0][0], QByteArray("A"));
+    QVERIFY(_items[0][1].isEmpty());
+}
+
+void TestItemsReader::emptyArray() {
+    QVERIFY(_reader.feed(" [ ] "));
+    QVERIFY(_reader.isComplete());
+    QCOMPARE(_reader.itemCount(), 0);
+}
+
+void TestItemsReader::incompleteDocument() {
+    QByteArray data = document(2);
+
+    QVERIFY(_reader.feed(data.left(data.size() - 20)));
+    QVERIFY(!_reader.isComplete());
+    QCOMPARE(_items.size(), 1);
+}
+
+void TestItemsReader::syntaxError_data() {
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("object instead of array") << QByteArray("{\"name\":\"A\"}");
+    QTest::newRow("unquoted key") << QByteArray("[{name:\"A\"}]");
+    QTest::newRow("missing colon") << QByteArray("[{\"name\" \"A\"}]");
+    QTest::newRow("missing comma") << QByteArray("[{\"name\":\"A\" \"state\":\"ON\"}]");
+}
+
+void TestItemsReader::syntaxError() {
+    QFETCH(QByteArray, data);
+
+    QVERIFY(!_reader.feed(data));
+    // the reader stays in the error state until it is reset
+    QVERIFY(!_reader.feed("[]"));
+    _reader.reset();
+    QVERIFY(_reader.feed("[]"));
+}
+
+void TestItemsReader::bufferOnlyHoldsOneItem() {
+    QByteArray data = document(1000);
+
+    for (int pos = 0; pos < data.size(); pos += 512) {
+        QVERIFY(_reader.feed(data.mid(pos, 512)));
+    }
+    QCOMPARE(_reader.itemCount(), 1000);
+    // one chunk and the rest of the previous item, not the whole document
+    QVERIFY(_reader.peakBufferSize() < 1024);
+}
+
+QTEST_APPLESS_MAIN(TestItemsReader)
+
+#include "tst_itemsreader.moc"
@@ -0,0 +1,6 @@
+include(../../tests.pri)
+
+TARGET   = tst_jsonscanner
+HEADERS += $$SRC_PATH/openhab_jsonscanner.h
+SOURCES += $$SRC_PATH/openhab_jsonscanner.cpp \
+    tst_jsonscanner.cpp
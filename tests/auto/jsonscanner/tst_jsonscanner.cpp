@@ -0,0 +1,180 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include <QtTest>
+
+#include "openhab_jsonscanner.h"
+
+using OpenHABJson::Token;
+
+class TestJsonScanner : public QObject {
+    Q_OBJECT
+
+ private slots:
+    void scanString();
+    void scanValue_data();
+    void scanValue();
+    void scanObject();
+    void scanObjectInvalid_data();
+    void scanObjectInvalid();
+    void unescape_data();
+    void unescape();
+    void tokenEquals();
+
+ private:
+    static QByteArray members(const QByteArray& json, bool* valid);
+};
+
+QByteArray TestJsonScanner::members(const QByteArray& json, bool* valid) {
+    QByteArray result;
+
+    *valid = OpenHABJson::scanObject(json.constData(), json.constData() + json.size(),
+                                     [&result](const Token& key, const Token& value) {
+                                         result += OpenHABJson::view(key.data, key.size) + '=' +
+                                                   OpenHABJson::view(value.data, value.size) + ';';
+                                     });
+    return result;
+}
+
+void TestJsonScanner::scanString() {
+    const QByteArray json("\"a\\\"b\" rest");
+    Token            token;
+
+    const char* end = OpenHABJson::scanString(json.constData(), json.constData() + json.size(), &token);
+    QVERIFY(end != nullptr);
+    QCOMPARE(QByteArray(end), QByteArray(" rest"));
+    QCOMPARE(OpenHABJson::view(token.data, token.size), QByteArray("a\\\"b"));
+    QVERIFY(token.escaped);
+
+    const QByteArray plain("\"plain\"");
+    QVERIFY(OpenHABJson::scanString(plain.constData(), plain.constData() + plain.size(), &token) != nullptr);
+    QVERIFY(!token.escaped);
+
+    // unterminated, also with an escape at the end
+    const QByteArray truncated("\"abc\\");
+    QVERIFY(OpenHABJson::scanString(truncated.constData(), truncated.constData() + truncated.size(), &token) ==
+            nullptr);
+}
+
+void TestJsonScanner::scanValue_data() {
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<bool>("valid");
+    QTest::addColumn<QByteArray>("value");
+
+    QTest::newRow("number") << QByteArray("12.5,") << true << QByteArray("12.5");
+    QTest::newRow("literal at end") << QByteArray("true}") << true << QByteArray("true");
+    QTest::newRow("string") << QByteArray("\"x,}\",") << true << QByteArray("x,}");
+    QTest::newRow("object") << QByteArray("{\"a\":{\"b\":[1,2]},\"c\":\"}\"},") << true
+                            << QByteArray("{\"a\":{\"b\":[1,2]},\"c\":\"}\"}");
+    QTest::newRow("array") << QByteArray("[{\"a\":\"]\"},[]] ,") << true << QByteArray("[{\"a\":\"]\"},[]]");
+    QTest::newRow("truncated object") << QByteArray("{\"a\":{\"b\":1}") << false << QByteArray();
+    QTest::newRow("truncated string in object") << QByteArray("{\"a\":\"b") << false << QByteArray();
+}
+
+void TestJsonScanner::scanValue() {
+    QFETCH(QByteArray, json);
+    QFETCH(bool, valid);
+    QFETCH(QByteArray, value);
+    Token token;
+
+    const char* end = OpenHABJson::scanValue(json.constData(), json.constData() + json.size(), &token);
+    QCOMPARE(end != nullptr, valid);
+    if (valid) {
+        QCOMPARE(OpenHABJson::view(token.data, token.size), value);
+    }
+}
+
+void TestJsonScanner::scanObject() {
+    bool valid = false;
+
+    QCOMPARE(members(" { } ", &valid), QByteArray());
+    QVERIFY(valid);
+    QCOMPARE(members("{\"a\":1,\"b\":\"x\"}", &valid), QByteArray("a=1;b=x;"));
+    QVERIFY(valid);
+    QCOMPARE(members("{ \"a\" :\n{\"inner\":1} , \"b\" : [ 1 ] }", &valid), QByteArray("a={\"inner\":1};b=[ 1 ];"));
+    QVERIFY(valid);
+}
+
+void TestJsonScanner::scanObjectInvalid_data() {
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("array") << QByteArray("[1]");
+    QTest::newRow("unquoted key") << QByteArray("{a:1}");
+    QTest::newRow("missing colon") << QByteArray("{\"a\" 1}");
+    QTest::newRow("missing value") << QByteArray("{\"a\":");
+    QTest::newRow("missing comma") << QByteArray("{\"a\":1 \"b\":2}");
+    QTest::newRow("trailing comma") << QByteArray("{\"a\":1,}");
+    QTest::newRow("truncated") << QByteArray("{\"a\":1");
+    QTest::newRow("truncated nested") << QByteArray("{\"a\":{\"b\":1}");
+}
+
+void TestJsonScanner::scanObjectInvalid() {
+    QFETCH(QByteArray, json);
+    bool valid = true;
+
+    members(json, &valid);
+    QVERIFY(!valid);
+}
+
+void TestJsonScanner::unescape_data() {
+    QTest::addColumn<QByteArray>("escaped");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("plain") << QByteArray("abc") << QByteArray("abc");
+    QTest::newRow("simple escapes") << QByteArray("\\\"\\\\\\/\\b\\f\\n\\r\\t") << QByteArray("\"\\/\b\f\n\r\t");
+    QTest::newRow("ascii") << QByteArray("\\u0041") << QByteArray("A");
+    QTest::newRow("2 bytes") << QByteArray("\\u00fc") << QByteArray("\xC3\xBC");
+    QTest::newRow("3 bytes") << QByteArray("\\u20AC") << QByteArray("\xE2\x82\xAC");
+    QTest::newRow("surrogate pair") << QByteArray("\\uD83D\\uDE00") << QByteArray("\xF0\x9F\x98\x80");
+    QTest::newRow("surrogate pair in text") << QByteArray("a\\uD83D\\uDE00b") << QByteArray("a\xF0\x9F\x98\x80" "b");
+    QTest::newRow("invalid hex") << QByteArray("\\u12G4") << QByteArray("?12G4");
+    QTest::newRow("truncated") << QByteArray("\\u12") << QByteArray("?12");
+    QTest::newRow("utf-8") << QByteArray("K\xC3\xBC" "che") << QByteArray("K\xC3\xBC" "che");
+}
+
+void TestJsonScanner::unescape() {
+    QFETCH(QByteArray, escaped);
+    QFETCH(QByteArray, expected);
+    Token      token;
+    QByteArray result;
+
+    token.data = escaped.constData();
+    token.size = escaped.size();
+    token.escaped = true;
+    OpenHABJson::unescape(token, &result);
+    QCOMPARE(result, expected);
+}
+
+void TestJsonScanner::tokenEquals() {
+    Token token;
+    token.data = "state";
+    token.size = 5;
+
+    QVERIFY(OpenHABJson::tokenEquals(token, "state"));
+    QVERIFY(!OpenHABJson::tokenEquals(token, "stat"));
+    QVERIFY(!OpenHABJson::tokenEquals(token, "states"));
+}
+
+QTEST_APPLESS_MAIN(TestJsonScanner)
+
+#include "tst_jsonscanner.moc"
@@ -0,0 +1,5 @@
+include(../../tests.pri)
+include(../../openhab.pri)
+
+TARGET   = tst_openhab
+SOURCES += tst_openhab.cpp
@@ -0,0 +1,222 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include <QtTest>
+
+#include "fakeopenhab.h"
+#include "openhab.h"
+#include "stubentities.h"
+#include "yio-interface/entities/blindinterface.h"
+#include "yio-interface/entities/lightinterface.h"
+#include "yio-interface/entities/switchinterface.h"
+
+/**
+ * Drives a real OpenHAB integration against the fake openHAB server.
+ */
+class TestOpenHAB : public QObject {
+    Q_OBJECT
+
+ private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void bootstrap();
+    void stateEvents();
+    void commands();
+    void blindPosition();
+    void optimisticEchoes();
+    void disconnectDuringBootstrap();
+
+ private:
+    void create(const QVariantMap& options = QVariantMap());
+    bool connectIntegration();
+
+    FakeOpenHAB*       _server = nullptr;
+    StubEntities*      _entities = nullptr;
+    StubNotifications* _notifications = nullptr;
+    OpenHABPlugin*     _plugin = nullptr;
+    OpenHAB*           _integration = nullptr;
+};
+
+void TestOpenHAB::initTestCase() { QStandardPaths::setTestModeEnabled(true); }
+
+void TestOpenHAB::init() {
+    _server = new FakeOpenHAB();
+    QVERIFY(_server->listen());
+    _server->addItem("Light_Kitchen", "Dimmer", "40");
+    _server->addItem("Blind_Living", "Rollershutter", "0");
+    _server->addItem("Switch_Fan", "Switch", "ON");
+    _server->addItem("Temperature_Living", "Number", "21.5");
+
+    _entities = new StubEntities();
+    _entities->add("light", "Light_Kitchen", {LightDef::F_BRIGHTNESS});
+    _entities->add("blind", "Blind_Living", {BlindDef::F_OPEN, BlindDef::F_CLOSE, BlindDef::F_POSITION});
+    _entities->add("switch", "Switch_Fan");
+    _notifications = new StubNotifications();
+    _plugin = new OpenHABPlugin();
+}
+
+void TestOpenHAB::cleanup() {
+    delete _integration;
+    delete _plugin;
+    delete _notifications;
+    delete _entities;
+    delete _server;
+    _integration = nullptr;
+}
+
+void TestOpenHAB::create(const QVariantMap& options) {
+    QVariantMap config{{"id", "openhab"}, {"friendly_name", "openHAB"}, {"url", _server->url()}, {"snapshotMaxAge", 0}};
+
+    for (auto i = options.constBegin(); i != options.constEnd(); ++i) {
+        config.insert(i.key(), i.value());
+    }
+    _integration = new OpenHAB(config, _entities, _notifications, nullptr, nullptr, _plugin);
+}
+
+bool TestOpenHAB::connectIntegration() {
+    Integration* integration = _integration;
+
+    integration->connect();
+    return QTest::qWaitFor(
+        [this, integration]() { return integration->state() == Integration::CONNECTED && _server->eventStreams() > 0; },
+        5000);
+}
+
+void TestOpenHAB::bootstrap() {
+    create();
+    QVERIFY(connectIntegration());
+
+    StubEntity* light = _entities->get("Light_Kitchen");
+    StubEntity* blind = _entities->get("Blind_Living");
+    StubEntity* fan = _entities->get("Switch_Fan");
+    QTRY_VERIFY(light->connected && blind->connected && fan->connected);
+    QTRY_COMPARE(light->attributes.value(LightDef::BRIGHTNESS).toInt(), 40);
+    QCOMPARE(light->state, int(LightDef::ON));
+    QCOMPARE(fan->state, int(SwitchDef::ON));
+    QCOMPARE(_server->requestCount("/rest/items"), 1);
+    QVERIFY(_notifications->messages.isEmpty());
+}
+
+void TestOpenHAB::stateEvents() {
+    create();
+    QVERIFY(connectIntegration());
+    StubEntity* light = _entities->get("Light_Kitchen");
+    StubEntity* fan = _entities->get("Switch_Fan");
+    QTRY_COMPARE(light->attributes.value(LightDef::BRIGHTNESS).toInt(), 40);
+
+    _server->sendStateEvent("Light_Kitchen", "Percent", "70");
+    _server->sendStateEvent("Switch_Fan", "OnOff", "OFF");
+    QTRY_COMPARE(light->attributes.value(LightDef::BRIGHTNESS).toInt(), 70);
+    QTRY_COMPARE(fan->state, int(SwitchDef::OFF));
+
+    _server->sendStateEvent("Light_Kitchen", "Percent", "0");
+    QTRY_COMPARE(light->state, int(LightDef::OFF));
+}
+
+void TestOpenHAB::commands() {
+    create();
+    QVERIFY(connectIntegration());
+    QSignalSpy received(_server, &FakeOpenHAB::commandReceived);
+
+    _integration->sendCommand("light", "Light_Kitchen", LightDef::C_BRIGHTNESS, 55);
+    QTRY_COMPARE(received.count(), 1);
+    _integration->sendCommand("switch", "Switch_Fan", SwitchDef::C_OFF, QVariant());
+    QTRY_COMPARE(received.count(), 2);
+
+    QCOMPARE(_server->commands().at(0), qMakePair(QByteArray("Light_Kitchen"), QByteArray("55")));
+    QCOMPARE(_server->commands().at(1), qMakePair(QByteArray("Switch_Fan"), QByteArray("OFF")));
+}
+
+void TestOpenHAB::blindPosition() {
+    create();
+    _server->setEchoCommands(true);
+    QVERIFY(connectIntegration());
+    StubEntity* blind = _entities->get("Blind_Living");
+
+    // openHAB reports 0% for an open rollershutter, the remote 100%
+    QTRY_COMPARE(blind->attributes.value(BlindDef::POSITION).toInt(), 100);
+    QCOMPARE(blind->state, int(BlindDef::OPEN));
+
+    _integration->sendCommand("blind", "Blind_Living", BlindDef::C_POSITION, 30);
+    QTRY_COMPARE(blind->attributes.value(BlindDef::POSITION).toInt(), 30);
+    QCOMPARE(_server->commands().last().second, QByteArray("70"));
+    QCOMPARE(_server->itemState("Blind_Living"), QByteArray("70"));
+    QCOMPARE(blind->state, int(BlindDef::CLOSED));
+
+    _integration->sendCommand("blind", "Blind_Living", BlindDef::C_CLOSE, QVariant());
+    QTRY_COMPARE(blind->attributes.value(BlindDef::POSITION).toInt(), 0);
+    QCOMPARE(_server->commands().last().second, QByteArray("DOWN"));
+
+    _integration->sendCommand("blind", "Blind_Living", BlindDef::C_OPEN, QVariant());
+    QTRY_COMPARE(blind->attributes.value(BlindDef::POSITION).toInt(), 100);
+    QCOMPARE(_server->commands().last().second, QByteArray("UP"));
+    QCOMPARE(blind->state, int(BlindDef::OPEN));
+}
+
+void TestOpenHAB::optimisticEchoes() {
+    create({{"optimistic", true}, {"optimisticTimeout", 5000}});
+    QVERIFY(connectIntegration());
+    QSignalSpy  received(_server, &FakeOpenHAB::commandReceived);
+    StubEntity* light = _entities->get("Light_Kitchen");
+    StubEntity* fan = _entities->get("Switch_Fan");
+    QTRY_COMPARE(light->attributes.value(LightDef::BRIGHTNESS).toInt(), 40);
+
+    _integration->sendCommand("light", "Light_Kitchen", LightDef::C_BRIGHTNESS, 20);
+    QTRY_COMPARE(received.count(), 1);
+    _integration->sendCommand("light", "Light_Kitchen", LightDef::C_BRIGHTNESS, 80);
+    QTRY_COMPARE(received.count(), 2);
+    QTRY_COMPARE(light->attributes.value(LightDef::BRIGHTNESS).toInt(), 80);
+    int shown = light->history.value(LightDef::BRIGHTNESS).size();
+
+    // the echo of the first command arrives while the second is pending, the fan marks the end of the echoes
+    _server->sendStateEvent("Light_Kitchen", "Percent", "20");
+    _server->sendStateEvent("Light_Kitchen", "Percent", "80");
+    _server->sendStateEvent("Switch_Fan", "OnOff", "OFF");
+    QTRY_COMPARE(fan->state, int(SwitchDef::OFF));
+    QVERIFY(!light->history.value(LightDef::BRIGHTNESS).mid(shown).contains(20));
+    QCOMPARE(light->attributes.value(LightDef::BRIGHTNESS).toInt(), 80);
+
+    // confirmed: later changes are shown again
+    _server->sendStateEvent("Light_Kitchen", "Percent", "30");
+    QTRY_COMPARE(light->attributes.value(LightDef::BRIGHTNESS).toInt(), 30);
+}
+
+void TestOpenHAB::disconnectDuringBootstrap() {
+    create();
+    Integration* integration = _integration;
+    _server->holdItems(true);
+
+    integration->connect();
+    QTRY_COMPARE(_server->requestCount("/rest/items"), 1);
+    integration->disconnect();
+    _server->releaseItems();
+
+    // the rest of the items document doesn't finish the aborted bootstrap
+    QTest::qWait(200);
+    QCOMPARE(integration->state(), int(Integration::DISCONNECTED));
+}
+
+QTEST_GUILESS_MAIN(TestOpenHAB)
+
+#include "tst_openhab.moc"
@@ -0,0 +1,6 @@
+include(../../tests.pri)
+
+TARGET   = tst_snapshot
+HEADERS += $$SRC_PATH/openhab_snapshot.h
+SOURCES += $$SRC_PATH/openhab_snapshot.cpp \
+    tst_snapshot.cpp
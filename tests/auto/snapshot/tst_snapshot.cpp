@@ -0,0 +1,205 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include <QDateTime>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "openhab_snapshot.h"
+
+static const char* URL = "http://openhab:8080/rest/";
+
+class TestSnapshot : public QObject {
+    Q_OBJECT
+
+ private slots:
+    void init();
+
+    void roundtrip();
+    void otherServer();
+    void maxAge_data();
+    void maxAge();
+    void invalid_data();
+    void invalid();
+    void missing();
+
+ private:
+    static QVector<OpenHABSnapshot::Record> records();
+    // writes a snapshot header like OpenHABSnapshot::write() with the given fields, followed by the records
+    static bool writeRaw(const QString& path, quint32 magic, quint16 version, qint64 created, const QString& url,
+                         const QVector<OpenHABSnapshot::Record>& records);
+
+    QTemporaryDir _dir;
+    QString       _path;
+};
+
+QVector<OpenHABSnapshot::Record> TestSnapshot::records() {
+    QVector<OpenHABSnapshot::Record> records;
+    OpenHABSnapshot::Record          record;
+
+    record.item = "Light_Kitchen";
+    record.entityId = "light.kitchen";
+    record.state = "ON";
+    record.type = "Dimmer";
+    records.append(record);
+
+    record.item = "Player_Title";
+    record.entityId = "media_player.living";
+    record.attribute = 3;
+    record.channel = "sonos:One:living:currenttitle";
+    record.state = "Caf\xc3\xa9 \"Live\" \xf0\x9f\x8e\xb5";
+    record.type = "String";
+    records.append(record);
+
+    record.item = "Light_Color";
+    record.entityId = "light.color";
+    record.attribute = -1;
+    record.channel.clear();
+    record.state.clear();  // state unknown
+    record.type = "Color";
+    records.append(record);
+    return records;
+}
+
+bool TestSnapshot::writeRaw(const QString& path, quint32 magic, quint16 version, qint64 created, const QString& url,
+                            const QVector<OpenHABSnapshot::Record>& records) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << magic << version << created << url << static_cast<quint32>(records.size());
+    for (const OpenHABSnapshot::Record& record : records) {
+        out << record.item << record.entityId << record.attribute << record.channel << record.state << record.type;
+    }
+    return out.status() == QDataStream::Ok;
+}
+
+void TestSnapshot::init() {
+    QVERIFY(_dir.isValid());
+    _path = _dir.filePath("openhab/snapshot.dat");
+    QFile::remove(_path);
+}
+
+void TestSnapshot::roundtrip() {
+    QVector<OpenHABSnapshot::Record> written = records();
+    QVector<OpenHABSnapshot::Record> read;
+
+    QVERIFY(OpenHABSnapshot::write(_path, URL, written));
+    QVERIFY(OpenHABSnapshot::read(_path, URL, 60, &read));
+    QCOMPARE(read.size(), written.size());
+    for (int i = 0; i < written.size(); ++i) {
+        QCOMPARE(read[i].item, written[i].item);
+        QCOMPARE(read[i].entityId, written[i].entityId);
+        QCOMPARE(read[i].attribute, written[i].attribute);
+        QCOMPARE(read[i].channel, written[i].channel);
+        QCOMPARE(read[i].state, written[i].state);
+        QCOMPARE(read[i].type, written[i].type);
+    }
+
+    // a new snapshot replaces the old one
+    written.removeLast();
+    QVERIFY(OpenHABSnapshot::write(_path, URL, written));
+    QVERIFY(OpenHABSnapshot::read(_path, URL, 60, &read));
+    QCOMPARE(read.size(), written.size());
+}
+
+void TestSnapshot::otherServer() {
+    QVector<OpenHABSnapshot::Record> read;
+
+    QVERIFY(OpenHABSnapshot::write(_path, URL, records()));
+    QVERIFY(!OpenHABSnapshot::read(_path, "http://other:8080/rest/", 60, &read));
+    QVERIFY(read.isEmpty());
+}
+
+void TestSnapshot::maxAge_data() {
+    QTest::addColumn<qint64>("age");
+    QTest::addColumn<int>("maxAge");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("fresh") << qint64(1000) << 60 << true;
+    QTest::newRow("an hour old, max a day") << qint64(3600) * 1000 << 86400 << true;
+    QTest::newRow("two days old, max a day") << qint64(2 * 86400) * 1000 << 86400 << false;
+    QTest::newRow("just expired") << qint64(61) * 1000 << 60 << false;
+    QTest::newRow("from the future") << qint64(-3600) * 1000 << 86400 << false;
+}
+
+void TestSnapshot::maxAge() {
+    QFETCH(qint64, age);
+    QFETCH(int, maxAge);
+    QFETCH(bool, valid);
+    QVector<OpenHABSnapshot::Record> read;
+
+    QVERIFY(QDir().mkpath(QFileInfo(_path).absolutePath()));
+    QVERIFY(writeRaw(_path, 0x4f485353, 2, QDateTime::currentMSecsSinceEpoch() - age, URL, records()));
+    QCOMPARE(OpenHABSnapshot::read(_path, URL, maxAge, &read), valid);
+    QCOMPARE(read.size(), valid ? records().size() : 0);
+}
+
+void TestSnapshot::invalid_data() {
+    QTest::addColumn<quint32>("magic");
+    QTest::addColumn<quint16>("version");
+    QTest::addColumn<int>("truncate");
+
+    QTest::newRow("magic") << quint32(0x12345678) << quint16(2) << 0;
+    QTest::newRow("old version") << quint32(0x4f485353) << quint16(1) << 0;
+    QTest::newRow("newer version") << quint32(0x4f485353) << quint16(3) << 0;
+    QTest::newRow("truncated record") << quint32(0x4f485353) << quint16(2) << 5;
+    QTest::newRow("truncated header") << quint32(0x4f485353) << quint16(2) << -10;
+}
+
+void TestSnapshot::invalid() {
+    QFETCH(quint32, magic);
+    QFETCH(quint16, version);
+    QFETCH(int, truncate);
+    QVector<OpenHABSnapshot::Record> read;
+
+    QVERIFY(QDir().mkpath(QFileInfo(_path).absolutePath()));
+    QVERIFY(writeRaw(_path, magic, version, QDateTime::currentMSecsSinceEpoch(), URL, records()));
+    if (truncate > 0) {
+        QFile file(_path);
+        QVERIFY(file.resize(file.size() - truncate));
+    } else if (truncate < 0) {
+        // keep the magic, the version and a part of the creation time
+        QFile file(_path);
+        QVERIFY(file.resize(-truncate));
+    }
+    QVERIFY(!OpenHABSnapshot::read(_path, URL, 60, &read));
+}
+
+void TestSnapshot::missing() {
+    QVector<OpenHABSnapshot::Record> read;
+
+    QVERIFY(!OpenHABSnapshot::read(_path, URL, 60, &read));
+
+    // an empty file can't be mapped
+    QVERIFY(QDir().mkpath(QFileInfo(_path).absolutePath()));
+    QFile file(_path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+    QVERIFY(!OpenHABSnapshot::read(_path, URL, 60, &read));
+}
+
+QTEST_APPLESS_MAIN(TestSnapshot)
+
+#include "tst_snapshot.moc"
@@ -0,0 +1,6 @@
+include(../../tests.pri)
+
+TARGET   = tst_sseparser
+HEADERS += $$SRC_PATH/openhab_sseparser.h
+SOURCES += $$SRC_PATH/openhab_sseparser.cpp \
+    tst_sseparser.cpp
@@ -0,0 +1,209 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include <QtTest>
+
+#include "openhab_sseparser.h"
+
+class TestSseParser : public QObject {
+    Q_OBJECT
+
+ private slots:
+    void singleEvent();
+    void multiLineData();
+    void eventTypeAndId();
+    void lineEndings_data();
+    void lineEndings();
+    void splitChunks();
+    void byteOrderMark();
+    void commentsAndUnknownFields();
+    void emptyDataIsNotDispatched();
+    void retry();
+    void partialEvent();
+    void reset();
+
+ private:
+    static QList<OpenHABSseParser::Event> takeAll(OpenHABSseParser* parser);
+};
+
+QList<OpenHABSseParser::Event> TestSseParser::takeAll(OpenHABSseParser* parser) {
+    QList<OpenHABSseParser::Event> events;
+    OpenHABSseParser::Event        event;
+    while (parser->takeEvent(&event)) {
+        events.append(event);
+    }
+    return events;
+}
+
+void TestSseParser::singleEvent() {
+    OpenHABSseParser parser;
+
+    parser.append("data: {\"topic\":\"openhab/items/Light/state\"}\n\n");
+    QList<OpenHABSseParser::Event> events = takeAll(&parser);
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].type, QByteArray("message"));
+    QCOMPARE(events[0].data, QByteArray("{\"topic\":\"openhab/items/Light/state\"}"));
+    QVERIFY(!parser.hasPartialEvent());
+}
+
+void TestSseParser::multiLineData() {
+    OpenHABSseParser parser;
+
+    parser.append("data: first\ndata:second\ndata\n\n");
+    QList<OpenHABSseParser::Event> events = takeAll(&parser);
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].data, QByteArray("first\nsecond\n"));
+}
+
+void TestSseParser::eventTypeAndId() {
+    OpenHABSseParser parser;
+
+    parser.append("event: alive\ndata: {\"type\":\"ALIVE\",\"interval\":10}\nid: 7\n\ndata: next\n\n");
+    QList<OpenHABSseParser::Event> events = takeAll(&parser);
+    QCOMPARE(events.size(), 2);
+    QCOMPARE(events[0].type, QByteArray("alive"));
+    QCOMPARE(events[0].id, QByteArray("7"));
+    // the type is reset after each event, the last event id is kept
+    QCOMPARE(events[1].type, QByteArray("message"));
+    QCOMPARE(events[1].id, QByteArray("7"));
+    QCOMPARE(parser.lastEventId(), QByteArray("7"));
+}
+
+void TestSseParser::lineEndings_data() {
+    QTest::addColumn<QByteArray>("stream");
+
+    QTest::newRow("LF") << QByteArray("data: a\n\ndata: b\n\n");
+    QTest::newRow("CRLF") << QByteArray("data: a\r\n\r\ndata: b\r\n\r\n");
+    QTest::newRow("CR") << QByteArray("data: a\r\rdata: b\r\r");
+    QTest::newRow("mixed") << QByteArray("data: a\r\n\ndata: b\r\r\n");
+}
+
+void TestSseParser::lineEndings() {
+    QFETCH(QByteArray, stream);
+    OpenHABSseParser parser;
+
+    // a CR at the end of the data can only be handled when the next byte is known
+    parser.append(stream + "data: c");
+    QList<OpenHABSseParser::Event> events = takeAll(&parser);
+    QCOMPARE(events.size(), 2);
+    QCOMPARE(events[0].data, QByteArray("a"));
+    QCOMPARE(events[1].data, QByteArray("b"));
+}
+
+void TestSseParser::splitChunks() {
+    const QByteArray stream("event: message\r\ndata: {\"value\":\"ON\"}\r\n\r\ndata: second\r\n\r\n");
+
+    // every split position, including a split between CR and LF
+    for (int split = 1; split < stream.size(); ++split) {
+        OpenHABSseParser parser;
+        parser.append(stream.left(split));
+        parser.append(stream.mid(split));
+        QList<OpenHABSseParser::Event> events = takeAll(&parser);
+        QCOMPARE(events.size(), 2);
+        QCOMPARE(events[0].data, QByteArray("{\"value\":\"ON\"}"));
+        QCOMPARE(events[1].data, QByteArray("second"));
+    }
+
+    // byte by byte
+    OpenHABSseParser parser;
+    for (char c : stream) {
+        parser.append(QByteArray(1, c));
+    }
+    QCOMPARE(takeAll(&parser).size(), 2);
+}
+
+void TestSseParser::byteOrderMark() {
+    OpenHABSseParser parser;
+
+    parser.append("\xEF\xBB");
+    parser.append("\xBF" "data: a\n\n");
+    QList<OpenHABSseParser::Event> events = takeAll(&parser);
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].data, QByteArray("a"));
+
+    // only at the start of the stream
+    parser.append("data: \xEF\xBB\xBF" "b\n\n");
+    events = takeAll(&parser);
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].data, QByteArray("\xEF\xBB\xBF" "b"));
+}
+
+void TestSseParser::commentsAndUnknownFields() {
+    OpenHABSseParser parser;
+
+    parser.append(": keep alive\n\nfoo: bar\ndata: a\n: comment inside\n\n");
+    QList<OpenHABSseParser::Event> events = takeAll(&parser);
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].data, QByteArray("a"));
+}
+
+void TestSseParser::emptyDataIsNotDispatched() {
+    OpenHABSseParser parser;
+
+    parser.append("event: alive\n\n\n\n");
+    QCOMPARE(takeAll(&parser).size(), 0);
+    parser.append("data: a\n\n");
+    QList<OpenHABSseParser::Event> events = takeAll(&parser);
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].type, QByteArray("message"));
+}
+
+void TestSseParser::retry() {
+    OpenHABSseParser parser;
+
+    QCOMPARE(parser.retry(), -1);
+    parser.append("retry: 5000\n\n");
+    QCOMPARE(parser.retry(), 5000);
+    parser.append("retry: -1\nretry: x\nretry: +3\n\n");
+    QCOMPARE(parser.retry(), 5000);
+}
+
+void TestSseParser::partialEvent() {
+    OpenHABSseParser parser;
+
+    parser.append("data: {\"topic\":");
+    QVERIFY(parser.hasPartialEvent());
+    QCOMPARE(takeAll(&parser).size(), 0);
+    parser.append("\"x\"}\n");
+    QVERIFY(parser.hasPartialEvent());
+    parser.append("\n");
+    QVERIFY(!parser.hasPartialEvent());
+    QList<OpenHABSseParser::Event> events = takeAll(&parser);
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].data, QByteArray("{\"topic\":\"x\"}"));
+}
+
+void TestSseParser::reset() {
+    OpenHABSseParser parser;
+
+    parser.append("data: lost\n");
+    parser.reset();
+    QVERIFY(!parser.hasPartialEvent());
+    parser.append("data: a\n\n");
+    QList<OpenHABSseParser::Event> events = takeAll(&parser);
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].data, QByteArray("a"));
+}
+
+QTEST_APPLESS_MAIN(TestSseParser)
+
+#include "tst_sseparser.moc"
@@ -0,0 +1,6 @@
+include(../../tests.pri)
+
+TARGET   = tst_stateparser
+HEADERS += $$SRC_PATH/openhab_stateparser.h
+SOURCES += $$SRC_PATH/openhab_stateparser.cpp \
+    tst_stateparser.cpp
@@ -0,0 +1,178 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include <QtTest>
+
+#include "openhab_stateparser.h"
+
+Q_DECLARE_METATYPE(OpenHABState::Type)
+
+class TestStateParser : public QObject {
+    Q_OBJECT
+
+ private slots:
+    void keywords_data();
+    void keywords();
+    void numbers_data();
+    void numbers();
+    void hsb_data();
+    void hsb();
+    void strings_data();
+    void strings();
+    void utf16();
+};
+
+void TestStateParser::keywords_data() {
+    QTest::addColumn<QByteArray>("literal");
+    QTest::addColumn<OpenHABState::Type>("type");
+    QTest::addColumn<bool>("on");
+
+    QTest::newRow("ON") << QByteArray("ON") << OpenHABState::ON_OFF << true;
+    QTest::newRow("OFF") << QByteArray("OFF") << OpenHABState::ON_OFF << false;
+    QTest::newRow("UP") << QByteArray("UP") << OpenHABState::UP_DOWN << true;
+    QTest::newRow("DOWN") << QByteArray("DOWN") << OpenHABState::UP_DOWN << false;
+    QTest::newRow("UNDEF") << QByteArray("UNDEF") << OpenHABState::UNDEF << false;
+    QTest::newRow("NULL") << QByteArray("NULL") << OpenHABState::NULL_STATE << false;
+    QTest::newRow("prefix") << QByteArray("ONLINE") << OpenHABState::STRING << false;
+    QTest::newRow("lower case") << QByteArray("on") << OpenHABState::STRING << false;
+    QTest::newRow("empty") << QByteArray() << OpenHABState::STRING << false;
+}
+
+void TestStateParser::keywords() {
+    QFETCH(QByteArray, literal);
+    QFETCH(OpenHABState::Type, type);
+    QFETCH(bool, on);
+
+    OpenHABState state = OpenHABStateParser::parse(literal);
+    QCOMPARE(state.type, type);
+    QCOMPARE(state.on, on);
+    QCOMPARE(state.toString(), QString::fromUtf8(literal));
+}
+
+void TestStateParser::numbers_data() {
+    QTest::addColumn<QByteArray>("literal");
+    QTest::addColumn<QByteArray>("itemType");
+    QTest::addColumn<OpenHABState::Type>("type");
+    QTest::addColumn<double>("number");
+
+    QTest::newRow("Dimmer") << QByteArray("42") << QByteArray("Dimmer") << OpenHABState::PERCENT << 42.0;
+    QTest::newRow("Number") << QByteArray("42") << QByteArray("Number") << OpenHABState::DECIMAL << 42.0;
+    QTest::newRow("Dimmer fraction") << QByteArray("12.5") << QByteArray("Dimmer") << OpenHABState::PERCENT << 12.5;
+    QTest::newRow("Dimmer zero") << QByteArray("0") << QByteArray("Dimmer") << OpenHABState::PERCENT << 0.0;
+    QTest::newRow("Number zero") << QByteArray("0") << QByteArray("Number") << OpenHABState::DECIMAL << 0.0;
+    QTest::newRow("Rollershutter") << QByteArray("100") << QByteArray("Rollershutter") << OpenHABState::PERCENT
+                                   << 100.0;
+    QTest::newRow("Color") << QByteArray("75") << QByteArray("Color") << OpenHABState::PERCENT << 75.0;
+    QTest::newRow("Percent event") << QByteArray("42") << QByteArray("Percent") << OpenHABState::PERCENT << 42.0;
+    QTest::newRow("Decimal event") << QByteArray("42") << QByteArray("Decimal") << OpenHABState::DECIMAL << 42.0;
+    QTest::newRow("no type") << QByteArray("42") << QByteArray() << OpenHABState::DECIMAL << 42.0;
+    QTest::newRow("Dimmer above 100") << QByteArray("230") << QByteArray("Dimmer") << OpenHABState::DECIMAL << 230.0;
+    QTest::newRow("negative") << QByteArray("-3.25") << QByteArray("Number") << OpenHABState::DECIMAL << -3.25;
+    QTest::newRow("quantity") << QByteArray("21.5 \xC2\xB0" "C") << QByteArray("Number:Temperature")
+                              << OpenHABState::DECIMAL << 21.5;
+    QTest::newRow("quantity below 100") << QByteArray("50 %") << QByteArray("Number:Dimensionless")
+                                        << OpenHABState::DECIMAL << 50.0;
+    QTest::newRow("leading dot") << QByteArray(".5") << QByteArray("Dimmer") << OpenHABState::PERCENT << 0.5;
+}
+
+void TestStateParser::numbers() {
+    QFETCH(QByteArray, literal);
+    QFETCH(QByteArray, itemType);
+    QFETCH(OpenHABState::Type, type);
+    QFETCH(double, number);
+
+    OpenHABState state = OpenHABStateParser::parse(literal, itemType);
+    QCOMPARE(state.type, type);
+    QVERIFY(state.isNumber());
+    QVERIFY(qAbs(state.number - number) < 1e-9);
+}
+
+void TestStateParser::hsb_data() {
+    QTest::addColumn<QByteArray>("literal");
+    QTest::addColumn<bool>("valid");
+    QTest::addColumn<double>("hue");
+    QTest::addColumn<double>("saturation");
+    QTest::addColumn<double>("brightness");
+
+    QTest::newRow("integers") << QByteArray("240,100,50") << true << 240.0 << 100.0 << 50.0;
+    QTest::newRow("fractions") << QByteArray("12.5,33.333,0") << true << 12.5 << 33.333 << 0.0;
+    QTest::newRow("two parts") << QByteArray("240,100") << false << 0.0 << 0.0 << 0.0;
+    QTest::newRow("four parts") << QByteArray("1,2,3,4") << false << 0.0 << 0.0 << 0.0;
+    QTest::newRow("empty part") << QByteArray("1,,3") << false << 0.0 << 0.0 << 0.0;
+    QTest::newRow("trailing text") << QByteArray("1,2,3x") << false << 0.0 << 0.0 << 0.0;
+}
+
+void TestStateParser::hsb() {
+    QFETCH(QByteArray, literal);
+    QFETCH(bool, valid);
+    QFETCH(double, hue);
+    QFETCH(double, saturation);
+    QFETCH(double, brightness);
+
+    OpenHABState state = OpenHABStateParser::parse(literal);
+    if (!valid) {
+        QCOMPARE(state.type, OpenHABState::STRING);
+        return;
+    }
+    QCOMPARE(state.type, OpenHABState::HSB);
+    QVERIFY(qAbs(state.hue - hue) < 1e-9);
+    QVERIFY(qAbs(state.saturation - saturation) < 1e-9);
+    QVERIFY(qAbs(state.brightness - brightness) < 1e-9);
+}
+
+void TestStateParser::strings_data() {
+    QTest::addColumn<QByteArray>("literal");
+
+    QTest::newRow("text") << QByteArray("PLAY");
+    QTest::newRow("number with text") << QByteArray("12abc");
+    QTest::newRow("sign only") << QByteArray("-");
+    QTest::newRow("utf-8") << QByteArray("K\xC3\xBC" "che");
+    QTest::newRow("date") << QByteArray("2021-03-01T10:00:00.000+0100");
+}
+
+void TestStateParser::strings() {
+    QFETCH(QByteArray, literal);
+
+    OpenHABState state = OpenHABStateParser::parse(literal);
+    QCOMPARE(state.type, OpenHABState::STRING);
+    QVERIFY(!state.isNumber());
+    QVERIFY(!state.isUndefined());
+    QCOMPARE(state.toString(), QString::fromUtf8(literal));
+}
+
+void TestStateParser::utf16() {
+    QString literal = QStringLiteral("21.5 °C");
+
+    OpenHABState state = OpenHABStateParser::parse(literal);
+    QCOMPARE(state.type, OpenHABState::DECIMAL);
+    QVERIFY(qAbs(state.number - 21.5) < 1e-9);
+    QCOMPARE(state.toString(), literal);
+
+    QCOMPARE(OpenHABStateParser::parse(QStringLiteral("ON")).type, OpenHABState::ON_OFF);
+    QCOMPARE(OpenHABStateParser::parse(QStringLiteral("1,2,3")).type, OpenHABState::HSB);
+    QCOMPARE(OpenHABStateParser::parse(QStringLiteral("42"), "Dimmer").type, OpenHABState::PERCENT);
+    QCOMPARE(OpenHABStateParser::parse(QStringLiteral("42"), "Number").type, OpenHABState::DECIMAL);
+}
+
+QTEST_APPLESS_MAIN(TestStateParser)
+
+#include "tst_stateparser.moc"
@@ -0,0 +1,6 @@
+TEMPLATE = subdirs
+SUBDIRS  = \
+    burst \
+    eventdecoder \
+    replay \
+    snapshot
@@ -0,0 +1,18 @@
+include(../../tests.pri)
+
+CONFIG  += benchmark
+TARGET   = tst_burst
+# the entity interface of integrations.library is replaced by a stub
+INCLUDEPATH += $$PWD/../../stubs
+HEADERS += $$PWD/../../stubs/yio-interface/entities/entityinterface.h \
+    $$SRC_PATH/openhab_entityupdater.h \
+    $$SRC_PATH/openhab_eventdecoder.h \
+    $$SRC_PATH/openhab_jsonscanner.h \
+    $$SRC_PATH/openhab_sseparser.h \
+    $$SRC_PATH/openhab_stateparser.h
+SOURCES += $$SRC_PATH/openhab_entityupdater.cpp \
+    $$SRC_PATH/openhab_eventdecoder.cpp \
+    $$SRC_PATH/openhab_jsonscanner.cpp \
+    $$SRC_PATH/openhab_sseparser.cpp \
+    $$SRC_PATH/openhab_stateparser.cpp \
+    tst_burst.cpp
@@ -0,0 +1,345 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include <QThread>
+#include <QtTest>
+
+#include "openhab_entityupdater.h"
+#include "openhab_eventdecoder.h"
+#include "openhab_sseparser.h"
+#include "openhab_stateparser.h"
+
+/**
+ * Stress harness for the event processing thread: replays a burst of recorded SSE data and measures how long the
+ * main thread, which drives the QML UI of the remote, is busy.
+ *
+ * "main thread" processes the stream on the main thread and changes the entities directly, like the integration did
+ * before it moved to the plugin worker thread. "worker thread" processes it on a worker thread and hands the state
+ * changes to the main thread through OpenHABEntityUpdater, like the integration does now.
+ *
+ * BURST_REPEAT sets how often the recording is replayed in one burst, 20 by default.
+ */
+
+// Measures the time the main thread spends in event handlers
+class BusyApplication : public QCoreApplication {
+ public:
+    BusyApplication(int& argc, char** argv) : QCoreApplication(argc, argv) {}
+
+    bool notify(QObject* receiver, QEvent* event) override {
+        if (!_measuring || QThread::currentThread() != thread()) {
+            return QCoreApplication::notify(receiver, event);
+        }
+        QElapsedTimer timer;
+        timer.start();
+        bool   result = QCoreApplication::notify(receiver, event);
+        qint64 busy = timer.nsecsElapsed();
+        _busy += busy;
+        _longest = qMax(_longest, busy);
+        _events++;
+        if (busy > FRAME_BUDGET) {
+            _overBudget++;
+        }
+        return result;
+    }
+
+    void startMeasuring() {
+        _busy = 0;
+        _longest = 0;
+        _events = 0;
+        _overBudget = 0;
+        _measuring = true;
+    }
+    void stopMeasuring() { _measuring = false; }
+
+    qint64 busy() const { return _busy; }
+    qint64 longest() const { return _longest; }
+    int    events() const { return _events; }
+    int    overBudget() const { return _overBudget; }
+
+    static const qint64 FRAME_BUDGET = 16 * 1000 * 1000;  // ns of a frame at 60 fps
+
+ private:
+    bool   _measuring = false;
+    qint64 _busy = 0;
+    qint64 _longest = 0;
+    int    _events = 0;
+    int    _overBudget = 0;
+};
+
+class StubEntity : public EntityInterface {
+ public:
+    enum Attributes { BRIGHTNESS = 1, VALUE = 2 };
+
+    QString type() override { return "light"; }
+    QString entity_id() override { return QString(); }
+    bool    isSupported(int) override { return true; }
+
+    void setState(int state) override {
+        this->state = state;
+        updates++;
+    }
+    bool updateAttrByIndex(int attrIndex, const QVariant& value) override {
+        attributes.insert(attrIndex, value);
+        updates++;
+        return true;
+    }
+    void setConnected(bool value) override { connected = value; }
+
+    int                  state = -1;
+    QHash<int, QVariant> attributes;
+    bool                 connected = false;
+    int                  updates = 0;
+};
+
+// Processes the stream like OpenHAB::streamReceived(), one chunk per event loop iteration like readyRead
+class BurstReplay : public QObject {
+    Q_OBJECT
+
+ public:
+    BurstReplay(const QList<QByteArray>& chunks, const QHash<QByteArray, StubEntity*>& entities, bool useUpdater)
+        : _chunks(chunks), _entities(entities), _useUpdater(useUpdater) {}
+
+    // processes all chunks at once, without an event loop and without updater
+    void replayAll();
+
+ public slots:
+    void start();
+
+ signals:
+    void finished();
+
+ private:
+    void feed(const QByteArray& chunk);
+    void feedNext();
+    void process(const QByteArray& data);
+    void setState(StubEntity* entity, int state);
+    void updateAttribute(StubEntity* entity, int attribute, const QVariant& value);
+
+    QList<QByteArray>              _chunks;
+    QHash<QByteArray, StubEntity*> _entities;
+    bool                           _useUpdater;
+    int                            _next = 0;
+    OpenHABSseParser               _parser;
+    OpenHABEventDecoder            _decoder;
+    OpenHABEntityUpdater*          _updater = nullptr;
+};
+
+void BurstReplay::replayAll() {
+    for (const QByteArray& chunk : qAsConst(_chunks)) {
+        feed(chunk);
+    }
+}
+
+void BurstReplay::start() {
+    _next = 0;
+    if (_useUpdater) {
+        // created on the thread of the replay, like the updater of the integration
+        _updater = new OpenHABEntityUpdater(this);
+        _updater->setMinInterval(16);  // ENTITY_UPDATE_INTERVAL of the integration
+    }
+    QMetaObject::invokeMethod(this, &BurstReplay::feedNext, Qt::QueuedConnection);
+}
+
+void BurstReplay::feed(const QByteArray& chunk) {
+    _parser.append(chunk);
+
+    OpenHABSseParser::Event event;
+    while (_parser.takeEvent(&event)) {
+        if (event.type == "message") {
+            process(event.data);
+        }
+    }
+}
+
+void BurstReplay::feedNext() {
+    feed(_chunks.at(_next++));
+    if (_next < _chunks.size()) {
+        QMetaObject::invokeMethod(this, &BurstReplay::feedNext, Qt::QueuedConnection);
+        return;
+    }
+    if (_updater != nullptr) {
+        // the last batch is queued to the main thread before finished()
+        _updater->flush();
+        delete _updater;
+        _updater = nullptr;
+    }
+    emit finished();
+}
+
+void BurstReplay::process(const QByteArray& data) {
+    QByteArray item = OpenHABEventDecoder::peekItem(data);
+    if (!item.isEmpty() && !_entities.contains(item)) {
+        return;
+    }
+    OpenHABEventDecoder::Event event;
+    if (!_decoder.decode(data, &event) || (event.type != OpenHABEventDecoder::ITEM_STATE &&
+                                           event.type != OpenHABEventDecoder::GROUP_ITEM_STATE_CHANGED)) {
+        return;
+    }
+    StubEntity* entity = _entities.value(event.item);
+    if (entity == nullptr) {
+        return;
+    }
+    OpenHABState state = OpenHABStateParser::parse(event.value.constData(), event.value.size(), event.valueType);
+    switch (state.type) {
+        case OpenHABState::ON_OFF:
+            setState(entity, state.on ? 1 : 0);
+            break;
+        case OpenHABState::PERCENT:
+            setState(entity, state.number > 0 ? 1 : 0);
+            updateAttribute(entity, StubEntity::BRIGHTNESS, qRound(state.number));
+            break;
+        case OpenHABState::UNDEF:
+        case OpenHABState::NULL_STATE:
+            break;
+        default:
+            updateAttribute(entity, StubEntity::VALUE, state.toString());
+            break;
+    }
+}
+
+void BurstReplay::setState(StubEntity* entity, int state) {
+    if (_updater != nullptr) {
+        _updater->setState(entity, state);
+    } else {
+        entity->setState(state);
+    }
+}
+
+void BurstReplay::updateAttribute(StubEntity* entity, int attribute, const QVariant& value) {
+    if (_updater != nullptr) {
+        _updater->updateAttribute(entity, attribute, value);
+    } else {
+        entity->updateAttrByIndex(attribute, value);
+    }
+}
+
+class TestBurst : public QObject {
+    Q_OBJECT
+
+ private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void burst_data();
+    void burst();
+
+ private:
+    QHash<QByteArray, StubEntity*> createEntities();
+
+    QList<QByteArray>              _chunks;
+    QHash<QByteArray, StubEntity*> _expected;  // entity states after processing the burst synchronously
+};
+
+QHash<QByteArray, StubEntity*> TestBurst::createEntities() {
+    QHash<QByteArray, StubEntity*> entities;
+    QList<QByteArray>              items;
+
+    items << "Light_Kitchen"
+          << "Light_Living"
+          << "Light_Color"
+          << "Blind_Living"
+          << "Player_Progress"
+          << "Player_Title"
+          << "Temperature_Living";
+    for (const QByteArray& item : qAsConst(items)) {
+        entities.insert(item, new StubEntity);
+    }
+    return entities;
+}
+
+void TestBurst::initTestCase() {
+    const int repeat = qEnvironmentVariableIsSet("BURST_REPEAT") ? qEnvironmentVariableIntValue("BURST_REPEAT") : 20;
+
+    QFile file(TESTS_DATA_DIR "/events.sse");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray recording = file.readAll();
+    QByteArray burst;
+    for (int i = 0; i < repeat; ++i) {
+        burst.append(recording);
+    }
+    // TCP segments
+    for (int pos = 0; pos < burst.size(); pos += 1460) {
+        _chunks.append(burst.mid(pos, 1460));
+    }
+
+    _expected = createEntities();
+    BurstReplay replay(_chunks, _expected, false);
+    replay.replayAll();
+}
+
+void TestBurst::cleanupTestCase() { qDeleteAll(_expected); }
+
+void TestBurst::burst_data() {
+    QTest::addColumn<bool>("workerThread");
+
+    QTest::newRow("main thread") << false;
+    QTest::newRow("worker thread") << true;
+}
+
+void TestBurst::burst() {
+    QFETCH(bool, workerThread);
+    BusyApplication* app = static_cast<BusyApplication*>(QCoreApplication::instance());
+
+    QHash<QByteArray, StubEntity*> entities = createEntities();
+    BurstReplay                    replay(_chunks, entities, workerThread);
+    QThread                        thread;
+    QEventLoop                     loop;
+    QElapsedTimer                  timer;
+
+    connect(&replay, &BurstReplay::finished, &loop, &QEventLoop::quit, Qt::QueuedConnection);
+    if (workerThread) {
+        replay.moveToThread(&thread);
+        thread.start();
+    }
+    app->startMeasuring();
+    timer.start();
+    QMetaObject::invokeMethod(&replay, "start", Qt::QueuedConnection);
+    loop.exec();
+    qint64 elapsed = timer.nsecsElapsed();
+    app->stopMeasuring();
+    thread.quit();
+    thread.wait();
+
+    int updates = 0;
+    for (auto i = entities.constBegin(); i != entities.constEnd(); ++i) {
+        const StubEntity* expected = _expected.value(i.key());
+        QCOMPARE((*i)->state, expected->state);
+        QCOMPARE((*i)->attributes, expected->attributes);
+        updates += (*i)->updates;
+    }
+    qDeleteAll(entities);
+
+    qInfo("%d chunks in %.1f ms, %d entity updates", _chunks.size(), elapsed / 1e6, updates);
+    qInfo("main thread busy %.1f ms (%.0f%%) in %d events, longest %.2f ms, %d events over the frame budget",
+          app->busy() / 1e6, app->busy() * 100.0 / elapsed, app->events(), app->longest() / 1e6, app->overBudget());
+}
+
+int main(int argc, char* argv[]) {
+    BusyApplication app(argc, argv);
+    TestBurst       test;
+
+    QTEST_SET_MAIN_SOURCE_PATH
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "tst_burst.moc"
@@ -0,0 +1,9 @@
+include(../../tests.pri)
+
+CONFIG  += benchmark
+TARGET   = tst_bench_eventdecoder
+HEADERS += $$SRC_PATH/openhab_eventdecoder.h \
+    $$SRC_PATH/openhab_jsonscanner.h
+SOURCES += $$SRC_PATH/openhab_eventdecoder.cpp \
+    $$SRC_PATH/openhab_jsonscanner.cpp \
+    tst_bench_eventdecoder.cpp
@@ -0,0 +1,183 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtTest>
+
+#include "openhab_eventdecoder.h"
+
+/**
+ * Compares the event decoder with the QJsonDocument based decoding which it replaced: the message was parsed into a
+ * document, the payload string was parsed again and every member access went through QJsonDocument::object().
+ */
+class BenchEventDecoder : public QObject {
+    Q_OBJECT
+
+ private slots:
+    void initTestCase();
+
+    void decode_data();
+    void decode();
+    void recording_data();
+    void recording();
+
+ private:
+    bool decodeWithJsonDocument(const QByteArray& data);
+    bool decodeWithEventDecoder(const QByteArray& data);
+
+    OpenHABEventDecoder _decoder;
+    QSet<QString>       _items;       // items of the integration, looked up by the replaced code
+    QSet<QByteArray>    _itemFilter;  // the same for the event decoder
+    QList<QByteArray>   _recording;   // data of the recorded messages
+    int                 _values = 0;  // number of decoded states, keeps the compiler from dropping the work
+};
+
+bool BenchEventDecoder::decodeWithJsonDocument(const QByteArray& data) {
+    QJsonParseError parseerror;
+    QJsonDocument   doc = QJsonDocument::fromJson(data, &parseerror);
+
+    if (parseerror.error != QJsonParseError::NoError) {
+        return false;
+    }
+    if (doc.object().value("type").toString() != "ItemStateEvent" &&
+        doc.object().value("type").toString() != "GroupItemStateChangedEvent") {
+        return true;
+    }
+    QString name = doc.object().value("topic").toString().split('/')[2];
+    if (!_items.contains(name)) {
+        return true;
+    }
+    QJsonDocument payload = QJsonDocument::fromJson(doc.object().value("payload").toString().toUtf8(), &parseerror);
+    if (parseerror.error != QJsonParseError::NoError) {
+        return false;
+    }
+    if (payload.object().value("value").toString() != "UNDEF") {
+        _values++;
+    }
+    return true;
+}
+
+bool BenchEventDecoder::decodeWithEventDecoder(const QByteArray& data) {
+    OpenHABEventDecoder::Event event;
+
+    QByteArray item = OpenHABEventDecoder::peekItem(data);
+    if (!item.isEmpty() && !_itemFilter.contains(item)) {
+        return true;
+    }
+    if (!_decoder.decode(data, &event)) {
+        return false;
+    }
+    if (event.type != OpenHABEventDecoder::ITEM_STATE && event.type != OpenHABEventDecoder::GROUP_ITEM_STATE_CHANGED) {
+        return true;
+    }
+    if (_itemFilter.contains(event.item) && event.value != "UNDEF") {
+        _values++;
+    }
+    return true;
+}
+
+void BenchEventDecoder::initTestCase() {
+    _items << "Light_Kitchen"
+           << "Light_Living"
+           << "Light_Color"
+           << "Blind_Living"
+           << "Player_Progress"
+           << "Player_Title"
+           << "Temperature_Living";
+    for (const QString& item : qAsConst(_items)) {
+        _itemFilter.insert(item.toUtf8());
+    }
+
+    QFile file(TESTS_DATA_DIR "/events.sse");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    for (const QByteArray& line : file.readAll().split('\n')) {
+        if (line.startsWith("data: {\"topic\"")) {
+            _recording.append(line.mid(6));
+        }
+    }
+    QVERIFY(!_recording.isEmpty());
+}
+
+void BenchEventDecoder::decode_data() {
+    QTest::addColumn<bool>("eventDecoder");
+    QTest::addColumn<QByteArray>("data");
+
+    const QByteArray state(
+        "{\"topic\":\"openhab/items/Light_Living/state\",\"payload\":\"{\\\"type\\\":\\\"Percent\\\",\\\"value\\\":"
+        "\\\"42\\\"}\",\"type\":\"ItemStateEvent\"}");
+    const QByteArray group(
+        "{\"topic\":\"openhab/items/Light_Kitchen/Light_Kitchen_1/statechanged\",\"payload\":\"{\\\"type\\\":"
+        "\\\"OnOff\\\",\\\"value\\\":\\\"ON\\\",\\\"oldType\\\":\\\"OnOff\\\",\\\"oldValue\\\":\\\"OFF\\\"}\","
+        "\"type\":\"GroupItemStateChangedEvent\"}");
+    const QByteArray title(
+        "{\"topic\":\"openhab/items/Player_Title/state\",\"payload\":\"{\\\"type\\\":\\\"String\\\",\\\"value\\\":"
+        "\\\"Caf\\u00e9 \\\\\\\"Live\\\\\\\" \\uD83C\\uDFB5\\\"}\",\"type\":\"ItemStateEvent\"}");
+    const QByteArray unconfigured(
+        "{\"topic\":\"openhab/items/Power_Meter_7/state\",\"payload\":\"{\\\"type\\\":\\\"Quantity\\\",\\\"value\\\":"
+        "\\\"1234.5 W\\\"}\",\"type\":\"ItemStateEvent\"}");
+
+    QTest::newRow("QJsonDocument: state") << false << state;
+    QTest::newRow("event decoder: state") << true << state;
+    QTest::newRow("QJsonDocument: group") << false << group;
+    QTest::newRow("event decoder: group") << true << group;
+    QTest::newRow("QJsonDocument: escaped title") << false << title;
+    QTest::newRow("event decoder: escaped title") << true << title;
+    QTest::newRow("QJsonDocument: unconfigured item") << false << unconfigured;
+    QTest::newRow("event decoder: unconfigured item") << true << unconfigured;
+}
+
+void BenchEventDecoder::decode() {
+    QFETCH(bool, eventDecoder);
+    QFETCH(QByteArray, data);
+    bool valid = true;
+
+    QBENCHMARK {
+        valid &= eventDecoder ? decodeWithEventDecoder(data) : decodeWithJsonDocument(data);
+    }
+    QVERIFY(valid);
+}
+
+void BenchEventDecoder::recording_data() {
+    QTest::addColumn<bool>("eventDecoder");
+
+    QTest::newRow("QJsonDocument") << false;
+    QTest::newRow("event decoder") << true;
+}
+
+void BenchEventDecoder::recording() {
+    QFETCH(bool, eventDecoder);
+    bool valid = true;
+
+    _values = 0;
+    QBENCHMARK {
+        for (const QByteArray& data : qAsConst(_recording)) {
+            valid &= eventDecoder ? decodeWithEventDecoder(data) : decodeWithJsonDocument(data);
+        }
+    }
+    QVERIFY(valid);
+    QVERIFY(_values > 0);
+}
+
+QTEST_APPLESS_MAIN(BenchEventDecoder)
+
+#include "tst_bench_eventdecoder.moc"
@@ -0,0 +1,6 @@
+include(../../tests.pri)
+include(../../openhab.pri)
+
+CONFIG  += benchmark
+TARGET   = tst_replay
+SOURCES += tst_replay.cpp
@@ -0,0 +1,251 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include <QtTest>
+#include <atomic>
+#include <functional>
+
+#include "fakeopenhab.h"
+#include "openhab.h"
+#include "stubentities.h"
+#include "yio-interface/entities/blindinterface.h"
+#include "yio-interface/entities/lightinterface.h"
+#include "yio-interface/entities/switchinterface.h"
+
+#ifdef __GLIBC__
+// counts the heap allocations of the whole process, Qt containers allocate with malloc instead of operator new
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+}
+
+static std::atomic<qint64> g_allocations(0);
+
+extern "C" void* malloc(size_t size) __THROW {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) __THROW {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) __THROW {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+
+static qint64 allocations() { return g_allocations.load(std::memory_order_relaxed); }
+#else
+static qint64 allocations() { return -1; }
+#endif
+
+/**
+ * Replays the recorded event stream in data/events.sse through a real OpenHAB integration, served by a fake openHAB
+ * server on localhost, and measures the /rest/items bootstrap. The numbers include the network stack of Qt, the
+ * allocations are counted for the whole process. The stream test can be configured with an environment variable:
+ *   REPLAY_REPEAT  number of times the recording is sent per iteration (default 20)
+ */
+class TestReplay : public QObject {
+    Q_OBJECT
+
+ private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void bootstrap_data();
+    void bootstrap();
+    void stream();
+
+ private:
+    bool connectIntegration();
+    bool waitFor(const std::function<bool()>& condition, int timeout = 10000);
+    void printMetrics(const QStringList& names);
+
+    static qint64 peakRss();
+
+    QByteArray         _recording;
+    int                _recordedEvents = 0;
+    FakeOpenHAB*       _server = nullptr;
+    StubEntities*      _entities = nullptr;
+    StubNotifications* _notifications = nullptr;
+    OpenHABPlugin*     _plugin = nullptr;
+    OpenHAB*           _integration = nullptr;
+};
+
+void TestReplay::initTestCase() {
+    QStandardPaths::setTestModeEnabled(true);
+
+    QFile file(TESTS_DATA_DIR "/events.sse");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    _recording = file.readAll();
+    _recordedEvents = _recording.count("event: message\n");
+    QVERIFY(_recordedEvents > 0);
+}
+
+void TestReplay::init() {
+    _server = new FakeOpenHAB();
+    QVERIFY(_server->listen());
+    // the items of the recording which are bound to entities
+    _server->addItem("Light_Kitchen", "Dimmer", "0");
+    _server->addItem("Light_Living", "Dimmer", "0");
+    _server->addItem("Light_Color", "Color", "0,0,0");
+    _server->addItem("Blind_Living", "Rollershutter", "0");
+    _server->addItem("Replay_Marker", "Switch", "OFF");
+
+    _entities = new StubEntities();
+    _entities->add("light", "Light_Kitchen", {LightDef::F_BRIGHTNESS});
+    _entities->add("light", "Light_Living", {LightDef::F_BRIGHTNESS});
+    _entities->add("light", "Light_Color", {LightDef::F_BRIGHTNESS, LightDef::F_COLOR});
+    _entities->add("blind", "Blind_Living", {BlindDef::F_OPEN, BlindDef::F_CLOSE, BlindDef::F_POSITION});
+    _entities->add("switch", "Replay_Marker");
+    _notifications = new StubNotifications();
+
+    QVariantMap config{{"id", "openhab"}, {"friendly_name", "openHAB"}, {"url", _server->url()}, {"snapshotMaxAge", 0}};
+    _plugin = new OpenHABPlugin();
+    _integration = new OpenHAB(config, _entities, _notifications, nullptr, nullptr, _plugin);
+}
+
+void TestReplay::cleanup() {
+    delete _integration;
+    delete _plugin;
+    delete _notifications;
+    delete _entities;
+    delete _server;
+}
+
+bool TestReplay::connectIntegration() {
+    Integration* integration = _integration;
+    integration->disconnect();
+    integration->connect();
+    return waitFor([integration]() { return integration->state() == Integration::CONNECTED; });
+}
+
+bool TestReplay::waitFor(const std::function<bool()>& condition, int timeout) {
+    QElapsedTimer timer;
+    QTimer        wakeUp;
+
+    // QTest::qWaitFor sleeps 10 ms between the checks, too coarse for the benchmarks
+    wakeUp.start(10);
+    timer.start();
+    while (!condition()) {
+        if (timer.hasExpired(timeout)) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    }
+    return true;
+}
+
+void TestReplay::printMetrics(const QStringList& names) {
+    QVariantMap metrics = _integration->metrics();
+    QStringList parts;
+
+    for (const QString& name : names) {
+        parts.append(QString("%1=%2").arg(name, metrics.value(name).toString()));
+    }
+    qInfo("metrics: %s", qPrintable(parts.join(' ')));
+}
+
+qint64 TestReplay::peakRss() {
+    // in KB, Linux only
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    for (const QByteArray& line : status.readAll().split('\n')) {
+        if (line.startsWith("VmHWM:")) {
+            return line.mid(6).trimmed().split(' ').first().toLongLong();
+        }
+    }
+    return -1;
+}
+
+void TestReplay::bootstrap_data() {
+    QTest::addColumn<int>("items");
+
+    QTest::newRow("100 items") << 100;
+    QTest::newRow("2000 items") << 2000;
+}
+
+void TestReplay::bootstrap() {
+    QFETCH(int, items);
+
+    // most items of an openHAB installation aren't used by the remote
+    for (int i = _server->itemCount(); i < items; ++i) {
+        _server->addItem("Item" + QByteArray::number(i), "Dimmer", QByteArray::number(i % 101));
+    }
+    int    reads = 0;
+    qint64 start = allocations();
+
+    QBENCHMARK {
+        QVERIFY(connectIntegration());
+        reads++;
+    }
+    qint64 allocated = allocations() - start;
+
+    QVERIFY(waitFor([this]() { return _entities->get("Light_Kitchen")->connected; }));
+    QVERIFY(_notifications->messages.isEmpty());
+    qInfo("%d bootstraps: %lld allocations per bootstrap, peak RSS %lld KB", reads, allocated / reads, peakRss());
+    printMetrics({"updatesApplied", "probeFailures"});
+}
+
+void TestReplay::stream() {
+    const int repeat = qEnvironmentVariableIsSet("REPLAY_REPEAT") ? qEnvironmentVariableIntValue("REPLAY_REPEAT") : 20;
+    StubEntity* marker = _entities->get("Replay_Marker");
+
+    QVERIFY(connectIntegration());
+    QVERIFY(waitFor([this]() { return _server->eventStreams() > 0; }));
+
+    bool          on = marker->state == SwitchDef::ON;
+    qint64        events = 0;
+    qint64        start = allocations();
+    QElapsedTimer timer;
+
+    timer.start();
+    QBENCHMARK {
+        for (int i = 0; i < repeat; ++i) {
+            _server->sendEvents(_recording);
+        }
+        // the stream is processed in order: the marker arrives after all events of the recording
+        on = !on;
+        _server->sendStateEvent("Replay_Marker", "OnOff", on ? "ON" : "OFF");
+        QVERIFY(waitFor([marker, on]() { return marker->state == (on ? SwitchDef::ON : SwitchDef::OFF); }));
+        events += qint64(_recordedEvents) * repeat + 1;
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+    qint64 allocated = allocations() - start;
+
+    QCOMPARE(_entities->get("Light_Kitchen")->connected, true);
+    QVERIFY(!_entities->get("Light_Color")->history.value(LightDef::COLOR).isEmpty());
+    qInfo("%lld events in %lld ms: %.0f events/s, %.1f allocations per event, peak RSS %lld KB", events,
+          elapsed / 1000000, events * 1e9 / elapsed, double(allocated) / events, peakRss());
+    printMetrics({"sseEvents", "ssePartialFrames", "eventsUnconfigured", "eventsRepeated", "eventsProcessed",
+                  "updatesApplied", "updatesCoalesced"});
+}
+
+QTEST_GUILESS_MAIN(TestReplay)
+
+#include "tst_replay.moc"
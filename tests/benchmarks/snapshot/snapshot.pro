@@ -0,0 +1,7 @@
+include(../../tests.pri)
+
+CONFIG  += benchmark
+TARGET   = tst_bench_snapshot
+HEADERS += $$SRC_PATH/openhab_snapshot.h
+SOURCES += $$SRC_PATH/openhab_snapshot.cpp \
+    tst_bench_snapshot.cpp
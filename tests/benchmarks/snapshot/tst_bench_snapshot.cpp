@@ -0,0 +1,110 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "openhab_snapshot.h"
+
+static const char* URL = "http://openhab:8080/rest/";
+
+/**
+ * Time to write and to read the snapshot of an installation with the given number of items. Reading is on the
+ * startup path: the states are applied before openHAB is reachable.
+ */
+class BenchSnapshot : public QObject {
+    Q_OBJECT
+
+ private slots:
+    void initTestCase();
+
+    void write_data();
+    void write();
+    void read_data();
+    void read();
+
+ private:
+    static QVector<OpenHABSnapshot::Record> records(int count);
+
+    QTemporaryDir _dir;
+};
+
+QVector<OpenHABSnapshot::Record> BenchSnapshot::records(int count) {
+    QVector<OpenHABSnapshot::Record> records;
+
+    records.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        OpenHABSnapshot::Record record;
+        record.item = QString("Item_%1").arg(i);
+        record.entityId = QString("light.item_%1").arg(i);
+        if (i % 4 == 0) {
+            // every fourth item belongs to a thing
+            record.attribute = i % 7;
+            record.channel = QString("hue:0210:bridge:bulb%1:color").arg(i);
+            record.state = "120,100,45";
+            record.type = "Color";
+        } else {
+            record.state = i % 2 ? "ON" : "42";
+            record.type = "Dimmer";
+        }
+        records.append(record);
+    }
+    return records;
+}
+
+void BenchSnapshot::initTestCase() { QVERIFY(_dir.isValid()); }
+
+void BenchSnapshot::write_data() {
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("50 items") << 50;
+    QTest::newRow("500 items") << 500;
+    QTest::newRow("5000 items") << 5000;
+}
+
+void BenchSnapshot::write() {
+    QFETCH(int, count);
+    QVector<OpenHABSnapshot::Record> written = records(count);
+    QString                          path = _dir.filePath(QString("write-%1.dat").arg(count));
+
+    QBENCHMARK {
+        QVERIFY(OpenHABSnapshot::write(path, URL, written));
+    }
+}
+
+void BenchSnapshot::read_data() { write_data(); }
+
+void BenchSnapshot::read() {
+    QFETCH(int, count);
+    QVector<OpenHABSnapshot::Record> read;
+    QString                          path = _dir.filePath(QString("read-%1.dat").arg(count));
+
+    QVERIFY(OpenHABSnapshot::write(path, URL, records(count)));
+    QBENCHMARK {
+        QVERIFY(OpenHABSnapshot::read(path, URL, 60, &read));
+    }
+    QCOMPARE(read.size(), count);
+}
+
+QTEST_APPLESS_MAIN(BenchSnapshot)
+
+#include "tst_bench_snapshot.moc"
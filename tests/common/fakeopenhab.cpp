@@ -0,0 +1,237 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "fakeopenhab.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrl>
+#include <QUrlQuery>
+
+FakeOpenHAB::FakeOpenHAB(QObject* parent) : QObject(parent) {
+    QObject::connect(&_server, &QTcpServer::newConnection, this, &FakeOpenHAB::onConnection);
+}
+
+bool FakeOpenHAB::listen() { return _server.listen(QHostAddress::LocalHost); }
+
+QString FakeOpenHAB::url() const { return QString("http://127.0.0.1:%1/").arg(_server.serverPort()); }
+
+void FakeOpenHAB::addItem(const QByteArray& name, const QByteArray& type, const QByteArray& state) {
+    _itemIndex.insert(name, _items.size());
+    _items.append({name, type, state});
+}
+
+QByteArray FakeOpenHAB::itemState(const QByteArray& name) const {
+    int index = _itemIndex.value(name, -1);
+    return index < 0 ? QByteArray() : _items[index].state;
+}
+
+void FakeOpenHAB::releaseItems() {
+    QList<QPair<QTcpSocket*, QByteArray>> heldItems;
+
+    _holdItems = false;
+    heldItems.swap(_heldItems);
+    for (const QPair<QTcpSocket*, QByteArray>& held : qAsConst(heldItems)) {
+        held.first->write(held.second);
+        held.first->disconnectFromHost();
+    }
+}
+
+int FakeOpenHAB::requestCount(const QByteArray& path) const { return _requests.value(path); }
+
+void FakeOpenHAB::sendEvents(const QByteArray& events) {
+    for (QTcpSocket* socket : qAsConst(_eventStreams)) {
+        socket->write(events);
+    }
+}
+
+void FakeOpenHAB::sendStateEvent(const QByteArray& item, const QByteArray& type, const QByteArray& value) {
+    int index = _itemIndex.value(item, -1);
+    if (index >= 0) {
+        _items[index].state = value;
+    }
+    QJsonObject payload{{"type", QString::fromUtf8(type)}, {"value", QString::fromUtf8(value)}};
+    QJsonObject event{{"topic", QString("openhab/items/%1/state").arg(QString::fromUtf8(item))},
+                      {"payload", QString::fromUtf8(QJsonDocument(payload).toJson(QJsonDocument::Compact))},
+                      {"type", "ItemStateEvent"}};
+    sendEvents("event: message\ndata: " + QJsonDocument(event).toJson(QJsonDocument::Compact) + "\n\n");
+}
+
+void FakeOpenHAB::onConnection() {
+    while (QTcpSocket* socket = _server.nextPendingConnection()) {
+        QObject::connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        QObject::connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            _buffers.remove(socket);
+            _eventStreams.removeOne(socket);
+            for (int i = _heldItems.size() - 1; i >= 0; --i) {
+                if (_heldItems[i].first == socket) {
+                    _heldItems.removeAt(i);
+                }
+            }
+            socket->deleteLater();
+        });
+    }
+}
+
+void FakeOpenHAB::onReadyRead(QTcpSocket* socket) {
+    QByteArray& buffer = _buffers[socket];
+    buffer.append(socket->readAll());
+
+    int headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        return;
+    }
+    QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+    QList<QByteArray> request = lines.first().trimmed().split(' ');
+    int               contentLength = 0;
+    for (const QByteArray& line : lines) {
+        if (line.toLower().startsWith("content-length:")) {
+            contentLength = line.mid(15).trimmed().toInt();
+        }
+    }
+    if (request.size() < 2 || buffer.size() < headerEnd + 4 + contentLength) {
+        return;
+    }
+    QByteArray body = buffer.mid(headerEnd + 4, contentLength);
+    buffer.clear();
+    handleRequest(socket, request[0], request[1], body);
+}
+
+void FakeOpenHAB::handleRequest(QTcpSocket* socket, const QByteArray& method, const QByteArray& target,
+                                const QByteArray& body) {
+    QUrl       url(QString::fromUtf8(target));
+    QByteArray path = url.path().toUtf8();
+    _requests[path]++;
+
+    if (method == "GET" && path == "/rest/systeminfo") {
+        reply(socket, 200, "{\"systemInfo\":{\"configFolder\":\"/etc/openhab\",\"osName\":\"Linux\"}}");
+    } else if (method == "GET" && path == "/rest/things") {
+        reply(socket, 200, "[]");
+    } else if (method == "GET" && path == "/rest/items") {
+        QByteArray document = itemsDocument(url.query().toUtf8());
+        if (!_holdItems) {
+            reply(socket, 200, document);
+            return;
+        }
+        // the headers and the first half now, the remaining half when released
+        int half = document.size() / 2;
+        socket->write("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+                      QByteArray::number(document.size()) + "\r\nConnection: close\r\n\r\n" + document.left(half));
+        _heldItems.append(qMakePair(socket, document.mid(half)));
+    } else if (method == "GET" && path == "/rest/events") {
+        socket->write("HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n"
+                      "Connection: close\r\n\r\n");
+        _eventStreams.append(socket);
+        emit eventStreamOpened();
+    } else if (path.startsWith("/rest/items/")) {
+        int index = _itemIndex.value(path.mid(12), -1);
+        if (index < 0) {
+            reply(socket, 404, "{\"error\":{\"message\":\"Item not found\",\"http-code\":404}}");
+        } else if (method == "GET") {
+            reply(socket, 200, itemJson(_items[index], {"link", "state", "type", "name", "groupNames"}));
+        } else if (method == "POST") {
+            Item item = _items[index];
+            _commands.append(qMakePair(item.name, body));
+            reply(socket, 200, QByteArray());
+            emit commandReceived(item.name, body);
+            if (_echoCommands) {
+                echoCommand(item, body);
+            }
+        } else {
+            reply(socket, 405, QByteArray());
+        }
+    } else {
+        reply(socket, 404, QByteArray());
+    }
+}
+
+void FakeOpenHAB::reply(QTcpSocket* socket, int status, const QByteArray& body) {
+    QByteArray reason = status == 200 ? "OK" : status == 404 ? "Not Found" : "Error";
+    socket->write("HTTP/1.1 " + QByteArray::number(status) + ' ' + reason +
+                  "\r\nContent-Type: application/json\r\nContent-Length: " + QByteArray::number(body.size()) +
+                  "\r\nConnection: close\r\n\r\n" + body);
+    socket->disconnectFromHost();
+}
+
+void FakeOpenHAB::echoCommand(const Item& item, const QByteArray& command) {
+    // the state openHAB reports after the command, commands like STOP or INCREASE don't have a predictable state
+    QByteArray state = command;
+    QByteArray type = "Decimal";
+    if (command == "ON" || command == "OFF") {
+        type = "OnOff";
+        if (item.type == "Dimmer" || item.type == "Rollershutter") {
+            state = command == "ON" ? "100" : "0";
+            type = "Percent";
+        }
+    } else if (command == "UP" || command == "DOWN") {
+        state = command == "UP" ? "0" : "100";
+        type = "Percent";
+    } else if (command.count(',') == 2) {
+        type = "HSB";
+    } else if (item.type == "Dimmer" || item.type == "Rollershutter" || item.type == "Color") {
+        type = "Percent";
+    } else if (item.type != "Number") {
+        return;
+    }
+    sendStateEvent(item.name, type, state);
+}
+
+QByteArray FakeOpenHAB::itemsDocument(const QByteArray& query) const {
+    QList<QByteArray> fields = QUrlQuery(QString::fromUtf8(query)).queryItemValue("fields").toUtf8().split(',');
+    QByteArray        document("[");
+
+    if (fields.first().isEmpty()) {
+        fields = {"link", "state", "type", "name", "groupNames"};
+    }
+    for (const Item& item : _items) {
+        if (document.size() > 1) {
+            document.append(',');
+        }
+        document.append(itemJson(item, fields));
+    }
+    document.append(']');
+    return document;
+}
+
+QByteArray FakeOpenHAB::itemJson(const Item& item, const QList<QByteArray>& fields) const {
+    QByteArray json("{");
+
+    // in the order of openHAB, only the requested fields
+    if (fields.contains("link")) {
+        json.append("\"link\":\"" + url().toUtf8() + "rest/items/" + item.name + "\",");
+    }
+    if (fields.contains("state")) {
+        json.append("\"state\":\"" + item.state + "\",");
+    }
+    if (fields.contains("type")) {
+        json.append("\"type\":\"" + item.type + "\",");
+    }
+    if (fields.contains("name")) {
+        json.append("\"name\":\"" + item.name + "\",");
+    }
+    if (fields.contains("groupNames")) {
+        json.append("\"groupNames\":[],");
+    }
+    json.chop(1);
+    json.append('}');
+    return json;
+}
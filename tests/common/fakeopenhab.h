@@ -0,0 +1,100 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QVector>
+
+/**
+ * @brief Minimal openHAB REST server on localhost for the tests of the integration.
+ *
+ * Serves /rest/systeminfo, /rest/items, /rest/items/<name>, /rest/things and the /rest/events stream, and accepts
+ * commands posted to /rest/items/<name>. Every response closes its connection, the event stream stays open until the
+ * server is destroyed. The topics filter of the event stream is ignored.
+ */
+class FakeOpenHAB : public QObject {
+    Q_OBJECT
+
+ public:
+    explicit FakeOpenHAB(QObject* parent = nullptr);
+
+    bool    listen();
+    QString url() const;
+
+    void       addItem(const QByteArray& name, const QByteArray& type, const QByteArray& state);
+    QByteArray itemState(const QByteArray& name) const;
+    int        itemCount() const { return _items.size(); }
+
+    // the bootstrap answers with half of the items document until releaseItems() is called
+    void holdItems(bool hold) { _holdItems = hold; }
+    void releaseItems();
+
+    // commands are answered with the state event openHAB would send
+    void setEchoCommands(bool echo) { _echoCommands = echo; }
+
+    const QList<QPair<QByteArray, QByteArray>>& commands() const { return _commands; }
+    int                                         eventStreams() const { return _eventStreams.size(); }
+    int                                         requestCount(const QByteArray& path) const;
+
+    // sends raw server-sent events, e.g. a recording, to all open event streams
+    void sendEvents(const QByteArray& events);
+    // updates the item and sends its ItemStateEvent, type is the value type of openHAB, e.g. "Percent" or "OnOff"
+    void sendStateEvent(const QByteArray& item, const QByteArray& type, const QByteArray& value);
+
+ signals:
+    void commandReceived(const QByteArray& item, const QByteArray& command);
+    void eventStreamOpened();
+
+ private:
+    struct Item {
+        QByteArray name;
+        QByteArray type;
+        QByteArray state;
+    };
+
+    void onConnection();
+    void onReadyRead(QTcpSocket* socket);
+    void handleRequest(QTcpSocket* socket, const QByteArray& method, const QByteArray& target, const QByteArray& body);
+    void reply(QTcpSocket* socket, int status, const QByteArray& body);
+    void echoCommand(const Item& item, const QByteArray& command);
+
+    QByteArray itemsDocument(const QByteArray& query) const;
+    QByteArray itemJson(const Item& item, const QList<QByteArray>& fields) const;
+
+    QTcpServer                            _server;
+    QVector<Item>                         _items;
+    QHash<QByteArray, int>                _itemIndex;
+    QHash<QTcpSocket*, QByteArray>        _buffers;
+    QList<QTcpSocket*>                    _eventStreams;
+    QList<QPair<QTcpSocket*, QByteArray>> _heldItems;
+    QList<QPair<QByteArray, QByteArray>>  _commands;
+    QHash<QByteArray, int>                _requests;
+    bool                                  _holdItems = false;
+    bool                                  _echoCommands = false;
+};
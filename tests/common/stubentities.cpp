@@ -0,0 +1,78 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "stubentities.h"
+
+StubEntity::StubEntity(const QString& type, const QString& entityId, const QSet<int>& features)
+    : _type(type), _entityId(entityId), _features(features) {}
+
+void StubEntity::setState(int state) {
+    this->state = state;
+    states.append(state);
+    updates++;
+}
+
+bool StubEntity::updateAttrByIndex(int attrIndex, const QVariant& value) {
+    attributes.insert(attrIndex, value);
+    history[attrIndex].append(value);
+    updates++;
+    return true;
+}
+
+StubEntities::~StubEntities() { qDeleteAll(_entities); }
+
+StubEntity* StubEntities::add(const QString& type, const QString& entityId, const QSet<int>& features) {
+    StubEntity* entity = new StubEntity(type, entityId, features);
+    _entities.append(entity);
+    return entity;
+}
+
+StubEntity* StubEntities::get(const QString& entityId) const {
+    for (StubEntity* entity : _entities) {
+        if (entity->entity_id() == entityId) {
+            return entity;
+        }
+    }
+    return nullptr;
+}
+
+QList<EntityInterface*> StubEntities::getByIntegration(const QString& integration) {
+    Q_UNUSED(integration)
+    QList<EntityInterface*> entities;
+    for (StubEntity* entity : qAsConst(_entities)) {
+        entities.append(entity);
+    }
+    return entities;
+}
+
+void StubNotifications::add(bool error, const QString& text, const QString& actionText,
+                            std::function<void(QObject*)> action, QObject* param) {
+    Q_UNUSED(actionText)
+    Q_UNUSED(action)
+    Q_UNUSED(param)
+    add(error, text);
+}
+
+void StubNotifications::add(bool error, const QString& text) {
+    Q_UNUSED(error)
+    messages.append(text);
+}
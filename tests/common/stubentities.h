@@ -0,0 +1,87 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include "yio-interface/entitiesinterface.h"
+#include "yio-interface/entities/entityinterface.h"
+#include "yio-interface/notificationsinterface.h"
+
+/**
+ * @brief Entity of the tests, records the updates of the integration.
+ */
+class StubEntity : public EntityInterface {
+ public:
+    StubEntity(const QString& type, const QString& entityId, const QSet<int>& features);
+
+    QString type() override { return _type; }
+    QString entity_id() override { return _entityId; }
+    bool    isSupported(int feature) override { return _features.contains(feature); }
+
+    void setConnected(bool value) override { connected = value; }
+    void setState(int state) override;
+    bool updateAttrByIndex(int attrIndex, const QVariant& value) override;
+
+    int                      state = -1;
+    QList<int>               states;  // all states, in the order of the updates
+    QHash<int, QVariant>     attributes;
+    QHash<int, QVariantList> history;  // all values of each attribute
+    bool                     connected = false;
+    int                      updates = 0;
+
+ private:
+    QString   _type;
+    QString   _entityId;
+    QSet<int> _features;
+};
+
+/**
+ * @brief Entities of the remote, all of them belong to the integration under test.
+ */
+class StubEntities : public EntitiesInterface {
+ public:
+    ~StubEntities() override;
+
+    StubEntity* add(const QString& type, const QString& entityId, const QSet<int>& features = QSet<int>());
+    StubEntity* get(const QString& entityId) const;
+
+    QList<EntityInterface*> getByIntegration(const QString& integration) override;
+
+ private:
+    QList<StubEntity*> _entities;
+};
+
+class StubNotifications : public NotificationsInterface {
+ public:
+    void add(bool error, const QString& text, const QString& actionText, std::function<void(QObject*)> action,
+             QObject* param) override;
+    void add(bool error, const QString& text) override;
+
+    QStringList messages;
+};
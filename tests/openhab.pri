@@ -0,0 +1,56 @@
+# The whole integration with the stubs of integrations.library in stubs/, for the tests which drive a real OpenHAB
+# instance against the fake openHAB server in common/. Include after tests.pri.
+QT += network gui
+
+INCLUDEPATH += $$PWD/stubs $$PWD/common $$OUT_PWD
+DEFINES += PLUGIN_VERSION=\\\"test\\\"
+
+# moc reads the metadata of the plugin class, which is generated from openhab.json.in in the plugin build
+write_file($$OUT_PWD/openhab.json, $$list("{ \"Name\": \"openHAB\" }"))
+
+HEADERS += $$PWD/stubs/yio-interface/configinterface.h \
+    $$PWD/stubs/yio-interface/entities/blindinterface.h \
+    $$PWD/stubs/yio-interface/entities/entityinterface.h \
+    $$PWD/stubs/yio-interface/entities/lightinterface.h \
+    $$PWD/stubs/yio-interface/entities/mediaplayerinterface.h \
+    $$PWD/stubs/yio-interface/entities/switchinterface.h \
+    $$PWD/stubs/yio-interface/entitiesinterface.h \
+    $$PWD/stubs/yio-interface/notificationsinterface.h \
+    $$PWD/stubs/yio-interface/plugininterface.h \
+    $$PWD/stubs/yio-interface/yioapiinterface.h \
+    $$PWD/stubs/yio-plugin/integration.h \
+    $$PWD/stubs/yio-plugin/plugin.h \
+    $$PWD/common/fakeopenhab.h \
+    $$PWD/common/stubentities.h \
+    $$SRC_PATH/openhab.h \
+    $$SRC_PATH/openhab_channelmappings.h \
+    $$SRC_PATH/openhab_commandqueue.h \
+    $$SRC_PATH/openhab_commandtracer.h \
+    $$SRC_PATH/openhab_entityupdater.h \
+    $$SRC_PATH/openhab_eventdecoder.h \
+    $$SRC_PATH/openhab_itemsreader.h \
+    $$SRC_PATH/openhab_jsonscanner.h \
+    $$SRC_PATH/openhab_metrics.h \
+    $$SRC_PATH/openhab_reconnectscheduler.h \
+    $$SRC_PATH/openhab_requestfactory.h \
+    $$SRC_PATH/openhab_snapshot.h \
+    $$SRC_PATH/openhab_sseparser.h \
+    $$SRC_PATH/openhab_stateparser.h
+SOURCES += $$PWD/stubs/yio-plugin/integration.cpp \
+    $$PWD/stubs/yio-plugin/plugin.cpp \
+    $$PWD/common/fakeopenhab.cpp \
+    $$PWD/common/stubentities.cpp \
+    $$SRC_PATH/openhab.cpp \
+    $$SRC_PATH/openhab_channelmappings.cpp \
+    $$SRC_PATH/openhab_commandqueue.cpp \
+    $$SRC_PATH/openhab_commandtracer.cpp \
+    $$SRC_PATH/openhab_entityupdater.cpp \
+    $$SRC_PATH/openhab_eventdecoder.cpp \
+    $$SRC_PATH/openhab_itemsreader.cpp \
+    $$SRC_PATH/openhab_jsonscanner.cpp \
+    $$SRC_PATH/openhab_metrics.cpp \
+    $$SRC_PATH/openhab_reconnectscheduler.cpp \
+    $$SRC_PATH/openhab_requestfactory.cpp \
+    $$SRC_PATH/openhab_snapshot.cpp \
+    $$SRC_PATH/openhab_sseparser.cpp \
+    $$SRC_PATH/openhab_stateparser.cpp
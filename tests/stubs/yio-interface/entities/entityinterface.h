@@ -0,0 +1,43 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QVariant>
+
+/**
+ * @brief Stand-in for the EntityInterface of integrations.library with the methods used by the integration.
+ *
+ * The stubs in this directory let the tests build the integration without the libraries of the remote.
+ */
+class EntityInterface {
+ public:
+    virtual ~EntityInterface() {}
+
+    virtual QString type() = 0;
+    virtual QString entity_id() = 0;
+    virtual bool    isSupported(int feature) = 0;
+    virtual void    setConnected(bool value) = 0;
+    virtual void    setState(int state) = 0;
+    virtual bool    updateAttrByIndex(int attrIndex, const QVariant& value) = 0;
+};
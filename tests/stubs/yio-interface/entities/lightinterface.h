@@ -0,0 +1,31 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+class LightDef {
+ public:
+    enum Attributes { STATE, BRIGHTNESS, COLOR, COLORTEMP };
+    enum States { OFF = 0, ON = 1 };
+    enum Features { F_BRIGHTNESS, F_COLOR, F_COLORTEMP };
+    enum Commands { C_TOGGLE, C_ON, C_OFF, C_BRIGHTNESS, C_COLOR, C_COLORTEMP };
+};
@@ -0,0 +1,53 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+class MediaPlayerDef {
+ public:
+    enum Attributes {
+        STATE,
+        SOURCE,
+        VOLUME,
+        MUTED,
+        MEDIATYPE,
+        MEDIATITLE,
+        MEDIAARTIST,
+        MEDIAIMAGE,
+        MEDIADURATION,
+        MEDIAPROGRESS
+    };
+    enum States { OFF = 0, ON = 1, IDLE = 2, PLAYING = 3 };
+    enum Commands {
+        C_TURNON,
+        C_TURNOFF,
+        C_PLAY,
+        C_PAUSE,
+        C_STOP,
+        C_PREVIOUS,
+        C_NEXT,
+        C_VOLUME_SET,
+        C_VOLUME_UP,
+        C_VOLUME_DOWN,
+        C_MUTE
+    };
+};
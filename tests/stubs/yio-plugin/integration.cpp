@@ -0,0 +1,43 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#include "yio-plugin/integration.h"
+
+#include "yio-plugin/plugin.h"
+
+Integration::Integration(const QVariantMap& config, EntitiesInterface* entities, NotificationsInterface* notifications,
+                         YioAPIInterface* api, ConfigInterface* configObj, Plugin* plugin)
+    : m_entities(entities),
+      m_notifications(notifications),
+      m_yioApi(api),
+      m_config(configObj),
+      m_logCategory(plugin->logCategory()),
+      m_integrationId(config.value("id").toString()),
+      m_friendlyName(config.value("friendly_name").toString()) {}
+
+void Integration::setState(int state) {
+    if (state == m_state) {
+        return;
+    }
+    m_state = state;
+    emit stateChanged(state);
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QLoggingCategory>
+#include <QObject>
+#include <QString>
+#include <QVariant>
+#include <QVariantMap>
+
+#include "yio-interface/configinterface.h"
+#include "yio-interface/entitiesinterface.h"
+#include "yio-interface/notificationsinterface.h"
+#include "yio-interface/yioapiinterface.h"
+
+class Plugin;
+
+/**
+ * @brief Stand-in for the Integration base class of integrations.library: configuration, connection state and the
+ *        interfaces of the remote.
+ */
+class Integration : public QObject {
+    Q_OBJECT
+
+ public:
+    enum States { CONNECTED = 0, CONNECTING = 1, DISCONNECTED = 2 };
+    Q_ENUM(States)
+
+    Integration(const QVariantMap& config, EntitiesInterface* entities, NotificationsInterface* notifications,
+                YioAPIInterface* api, ConfigInterface* configObj, Plugin* plugin);
+
+    int     state() const { return m_state; }
+    void    setState(int state);
+    QString integrationId() const { return m_integrationId; }
+    QString friendlyName() const { return m_friendlyName; }
+
+    virtual void sendCommand(const QString& type, const QString& entityId, int command, const QVariant& param) = 0;
+
+ signals:
+    void stateChanged(int state);
+
+ public slots:
+    virtual void connect() = 0;
+    virtual void disconnect() = 0;
+    virtual void enterStandby() {}
+    virtual void leaveStandby() {}
+
+ protected:
+    EntitiesInterface*      m_entities;
+    NotificationsInterface* m_notifications;
+    YioAPIInterface*        m_yioApi;
+    ConfigInterface*        m_config;
+    QLoggingCategory&       m_logCategory;
+
+ private:
+    int     m_state = DISCONNECTED;
+    QString m_integrationId;
+    QString m_friendlyName;
+};
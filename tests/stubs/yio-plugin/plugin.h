@@ -0,0 +1,60 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2021 Contributors of integration.openhab
+ *
+ * This file is part of the YIO-Remote software project.
+ *
+ * YIO-Remote software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YIO-Remote software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YIO-Remote software. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *****************************************************************************/
+
+#pragma once
+
+#include <QLoggingCategory>
+#include <QObject>
+#include <QVariantMap>
+
+#include "yio-interface/plugininterface.h"
+
+class ConfigInterface;
+class EntitiesInterface;
+class Integration;
+class NotificationsInterface;
+class YioAPIInterface;
+
+/**
+ * @brief Stand-in for the Plugin base class of integrations.library. The tests create the integrations directly, the
+ *        plugin only provides the log category.
+ */
+class Plugin : public QObject, public PluginInterface {
+    Q_OBJECT
+    Q_INTERFACES(PluginInterface)
+
+ public:
+    Plugin(const char* pluginName, bool useWorkerThread);
+
+    QLoggingCategory& logCategory() { return m_logCategory; }
+    bool              useWorkerThread() const { return m_useWorkerThread; }
+
+ protected:
+    virtual Integration* createIntegration(const QVariantMap& config, EntitiesInterface* entities,
+                                           NotificationsInterface* notifications, YioAPIInterface* api,
+                                           ConfigInterface* configObj) = 0;
+
+    QLoggingCategory m_logCategory;
+
+ private:
+    bool m_useWorkerThread;
+};
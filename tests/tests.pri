@@ -0,0 +1,8 @@
+TEMPLATE = app
+QT       = core testlib
+CONFIG  += console testcase c++11
+CONFIG  -= app_bundle
+
+SRC_PATH = $$PWD/../src
+INCLUDEPATH += $$SRC_PATH
+DEFINES += TESTS_DATA_DIR=\\\"$$PWD/data\\\"
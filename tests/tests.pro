@@ -0,0 +1,7 @@
+# Unit tests and benchmarks. The parser tests only need QtCore and QtTest, the tests of the whole integration include
+# openhab.pri: they build it with the stubs of integrations.library and also need QtNetwork and QtGui.
+#
+#   qmake tests/tests.pro && make check      runs the unit tests
+#   make benchmark                           runs the benchmarks, e.g. with TESTARGS="-median 5"
+TEMPLATE = subdirs
+SUBDIRS  = auto benchmarks